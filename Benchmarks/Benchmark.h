@@ -0,0 +1,185 @@
+#pragma once
+
+#include "../TestSupport/SilenceStdout.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Keeps the compiler from optimizing away a value that is computed but unused.
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+struct BenchmarkOptions {
+	std::string jsonPath;	// Also write the results as JSON when set.
+	std::size_t warmupRepetitions = 3;
+	std::size_t repetitions = 15;
+	std::chrono::nanoseconds minRepetitionTime = std::chrono::milliseconds(10);
+	std::string filter;	// Only run benchmarks whose name contains this.
+};
+
+struct BenchmarkResult {
+	std::string name;
+	std::size_t iterations;		// Per repetition.
+	std::size_t repetitions;
+	double medianNs;		// Per iteration.
+	double madNs;
+	double minNs;
+};
+
+/**
+ * A small micro-benchmark harness.
+ * Every benchmark is warmed up, which also calibrates how many iterations
+ * make one repetition last 'minRepetitionTime', and then timed over a number
+ * of repetitions. The time per iteration is reported as the median over the
+ * repetitions together with the median absolute deviation (MAD), which is
+ * far less sensitive to outliers than the mean and standard deviation.
+ */
+class BenchmarkSuite {
+public:
+	explicit BenchmarkSuite(const BenchmarkOptions& options = BenchmarkOptions{})
+		: m_options(options)
+	{
+	}
+
+	// Times 'body()', one call per iteration.
+	template<typename Body>
+	void Run(const std::string& name, Body&& body) {
+		if (!m_options.filter.empty() && name.find(m_options.filter) == std::string::npos) {
+			return;
+		}
+
+		// Calibrate: grow the iteration count until a repetition is long enough.
+		std::size_t iterations = 1;
+		for (;;) {
+			const double elapsed = TimeIterations(body, iterations);
+			if (elapsed >= static_cast<double>(m_options.minRepetitionTime.count()) || iterations >= (std::size_t(1) << 30)) {
+				break;
+			}
+			const double scale = elapsed > 0.0 ? static_cast<double>(m_options.minRepetitionTime.count()) / elapsed : 10.0;
+			iterations = static_cast<std::size_t>(static_cast<double>(iterations) * std::min(10.0, std::max(1.5, scale * 1.1))) + 1;
+		}
+		for (std::size_t i = 0; i < m_options.warmupRepetitions; ++i) {
+			TimeIterations(body, iterations);
+		}
+
+		std::vector<double> samples;
+		samples.reserve(m_options.repetitions);
+		for (std::size_t i = 0; i < std::max<std::size_t>(1, m_options.repetitions); ++i) {
+			samples.push_back(TimeIterations(body, iterations) / static_cast<double>(iterations));
+		}
+
+		BenchmarkResult result{ name, iterations, samples.size(), Median(samples), 0.0,
+			*std::min_element(samples.begin(), samples.end()) };
+		for (auto& sample : samples) {
+			sample = std::fabs(sample - result.medianNs);
+		}
+		result.madNs = Median(samples);
+
+		std::printf("%-48s %12.2f ns %10.2f ns %12zu\n", name.c_str(), result.medianNs, result.madNs, iterations);
+		std::fflush(stdout);
+		m_results.push_back(result);
+	}
+
+	void PrintHeader() const {
+		std::printf("%-48s %15s %13s %12s\n", "benchmark", "median", "MAD", "iterations");
+	}
+
+	// Writes the JSON report if one was requested. Returns the exit code for main.
+	int Finish() const {
+		if (m_options.jsonPath.empty()) {
+			return 0;
+		}
+		std::ofstream file(m_options.jsonPath);
+		WriteJson(file);
+		if (!file) {
+			std::fprintf(stderr, "Unable to write '%s'\n", m_options.jsonPath.c_str());
+			return 1;
+		}
+		return 0;
+	}
+
+	void WriteJson(std::ostream& os) const {
+		os << "{\n  \"benchmarks\": [\n";
+		for (std::size_t i = 0; i < m_results.size(); ++i) {
+			const BenchmarkResult& r = m_results[i];
+			os << "    { \"name\": \"" << Escape(r.name) << "\", \"iterations\": " << r.iterations
+				<< ", \"repetitions\": " << r.repetitions << ", \"median_ns\": " << r.medianNs
+				<< ", \"mad_ns\": " << r.madNs << ", \"min_ns\": " << r.minNs << " }"
+				<< (i + 1 < m_results.size() ? ",\n" : "\n");
+		}
+		os << "  ]\n}\n";
+	}
+
+	const std::vector<BenchmarkResult>& GetResults() const { return m_results; }
+
+private:
+	template<typename Body>
+	static double TimeIterations(Body& body, std::size_t iterations) {
+		const auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < iterations; ++i) {
+			body();
+		}
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	static double Median(std::vector<double> values) {
+		std::sort(values.begin(), values.end());
+		const std::size_t mid = values.size() / 2;
+		return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+	}
+
+	static std::string Escape(const std::string& text) {
+		std::string escaped;
+		for (const char c : text) {
+			if (c == '"' || c == '\\') {
+				escaped += '\\';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	BenchmarkOptions m_options;
+	std::vector<BenchmarkResult> m_results;
+};
+
+/**
+ * Reads the common benchmark options from the command line:
+ * --json <file>, --filter <text>, --repetitions <n> and --warmup <n>.
+ * Other arguments are ignored, so a benchmark can add its own.
+ */
+inline BenchmarkOptions ParseBenchmarkOptions(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (std::strcmp(argv[i], "--json") == 0) {
+			options.jsonPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--filter") == 0) {
+			options.filter = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--repetitions") == 0) {
+			options.repetitions = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--warmup") == 0) {
+			options.warmupRepetitions = std::strtoull(argv[++i], nullptr, 10);
+		}
+	}
+	return options;
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "Player.h"
+#include "../Platform/MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+	#include <io.h>
+#else
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/**
+ * On-disk layout of the command journal:
+ * a 'JournalHeader' followed by tightly packed, fixed-size 'JournalRecord's.
+ * Since every record has the same size, the offset of command 'i' is
+ * 'sizeof(JournalHeader) + i * sizeof(JournalRecord)', so seeking to any
+ * command index needs no separate offset index.
+ *
+ * A journal belongs to one Invoker session: receiver ids are handed out by
+ * the Invoker that writes the journal, in the order it first sees each
+ * receiver, and a new Invoker starts again at 0. Start a new journal file
+ * for every Invoker, or register the receivers in the same order again
+ * before appending to an existing one.
+ *
+ * The journal holds the command history, not the Invoker's cursor: 'Undo'
+ * and 'RewindTo' are not recorded. Replaying a whole journal gives the state
+ * with every command applied, so a caller that needs to come back rewound
+ * must persist the position itself and replay only [0, position).
+ */
+struct JournalHeader {
+	char magic[4];			// "CMDJ"
+	std::uint32_t version;
+	std::uint32_t recordSize;
+	std::uint32_t reserved;
+};
+
+struct JournalRecord {
+	std::uint32_t receiver;		// Receiver id, in the Invoker's registration order.
+	std::int16_t dx;
+	std::int16_t dy;
+};
+
+static_assert(sizeof(JournalHeader) == 16, "Unexpected journal header layout");
+static_assert(sizeof(JournalRecord) == 8, "Unexpected journal record layout");
+
+constexpr std::uint32_t kJournalVersion = 1;
+
+inline bool IsValidJournalHeader(const JournalHeader& header) {
+	return std::memcmp(header.magic, "CMDJ", 4) == 0
+		&& header.version == kJournalVersion
+		&& header.recordSize == sizeof(JournalRecord);
+}
+
+/**
+ * Appends records to a journal file.
+ * Records are collected in a buffer that is written out when it is full,
+ * and 'Commit' makes everything appended so far durable with a single sync,
+ * so a whole batch of commands shares the cost of one flush (group commit).
+ * Reopening an existing journal drops a torn trailing record left by a
+ * crash, so the records appended afterwards stay aligned.
+ */
+class CommandJournalWriter {
+public:
+	explicit CommandJournalWriter(const std::string& path, std::size_t bufferRecords = 64 * 1024)
+		: m_file(std::fopen(path.c_str(), "rb+"))
+	{
+		if (!m_file) {
+			m_file = std::fopen(path.c_str(), "wb+");
+		}
+		if (!m_file) {
+			throw std::runtime_error("Unable to open journal '" + path + "'");
+		}
+		m_buffer.reserve(bufferRecords > 0 ? bufferRecords : 1);
+
+		// A new journal starts with a header, an existing one is appended to.
+		const std::uint64_t size = GetFileSize();
+		if (size == 0) {
+			const JournalHeader header{ { 'C', 'M', 'D', 'J' }, kJournalVersion, sizeof(JournalRecord), 0 };
+			Write(&header, sizeof(header));
+			return;
+		}
+
+		JournalHeader header{};
+		if (size < sizeof(header) || std::fread(&header, sizeof(header), 1, m_file) != 1 || !IsValidJournalHeader(header)) {
+			std::fclose(m_file);
+			throw std::runtime_error("Journal '" + path + "' is corrupt");
+		}
+
+		const std::uint64_t valid = sizeof(JournalHeader) + (size - sizeof(JournalHeader)) / sizeof(JournalRecord) * sizeof(JournalRecord);
+		if (valid != size && !Truncate(valid)) {
+			std::fclose(m_file);
+			throw std::runtime_error("Unable to repair journal '" + path + "'");
+		}
+		std::fseek(m_file, 0, SEEK_END);
+	}
+
+	CommandJournalWriter(const CommandJournalWriter&) = delete;
+	CommandJournalWriter& operator=(const CommandJournalWriter&) = delete;
+
+	// Call 'Commit' before destruction to see write errors; they are ignored here.
+	~CommandJournalWriter() {
+		try {
+			Flush();
+		}
+		catch (const std::runtime_error&) {
+		}
+		std::fclose(m_file);
+	}
+
+	// Deltas must fit a record's int16_t fields, so that record i stays command i.
+	void Append(std::uint32_t receiver, int dx, int dy) {
+		if (dx < INT16_MIN || dx > INT16_MAX || dy < INT16_MIN || dy > INT16_MAX) {
+			throw std::out_of_range("Command delta does not fit a journal record");
+		}
+		if (m_buffer.size() == m_buffer.capacity()) {
+			Flush();
+		}
+		m_buffer.push_back({ receiver, static_cast<std::int16_t>(dx), static_cast<std::int16_t>(dy) });
+	}
+
+	// Writes the buffered records and syncs the file to disk. Stdio buffers
+	// the writes, so most I/O errors (e.g. a full disk) only show up here.
+	void Commit() {
+		Flush();
+#if defined(_WIN32)
+		const bool synced = std::fflush(m_file) == 0 && _commit(_fileno(m_file)) == 0;
+#else
+		const bool synced = std::fflush(m_file) == 0 && fdatasync(fileno(m_file)) == 0;
+#endif
+		if (!synced) {
+			throw std::runtime_error("Failed to sync the journal");
+		}
+	}
+
+private:
+	void Flush() {
+		if (!m_buffer.empty()) {
+			Write(m_buffer.data(), m_buffer.size() * sizeof(JournalRecord));
+			m_buffer.clear();
+		}
+	}
+
+	std::uint64_t GetFileSize() const {
+#if defined(_WIN32)
+		return static_cast<std::uint64_t>(_filelengthi64(_fileno(m_file)));
+#else
+		struct stat info{};
+		return fstat(fileno(m_file), &info) == 0 ? static_cast<std::uint64_t>(info.st_size) : 0;
+#endif
+	}
+
+	bool Truncate(std::uint64_t size) {
+		std::fflush(m_file);
+#if defined(_WIN32)
+		return _chsize_s(_fileno(m_file), static_cast<long long>(size)) == 0;
+#else
+		return ftruncate(fileno(m_file), static_cast<off_t>(size)) == 0;
+#endif
+	}
+
+	void Write(const void* data, std::size_t size) {
+		if (std::fwrite(data, 1, size, m_file) != size) {
+			throw std::runtime_error("Failed to write to the journal");
+		}
+	}
+
+	std::FILE* m_file;
+	std::vector<JournalRecord> m_buffer;
+};
+
+/**
+ * Memory-maps a journal for replay.
+ * Records are read straight from the mapped pages; a partially written
+ * trailing record (e.g. after a crash) is ignored.
+ */
+class CommandJournalReader {
+public:
+	explicit CommandJournalReader(const std::string& path)
+		: m_file(path)
+	{
+		JournalHeader header{};
+		if (m_file.GetSize() >= sizeof(header)) {
+			std::memcpy(&header, m_file.GetData(), sizeof(header));
+		}
+		if (!IsValidJournalHeader(header)) {
+			throw std::runtime_error("Journal '" + path + "' is corrupt");
+		}
+
+		m_records = reinterpret_cast<const JournalRecord*>(m_file.GetData() + sizeof(JournalHeader));
+		m_count = (m_file.GetSize() - sizeof(JournalHeader)) / sizeof(JournalRecord);
+	}
+
+	CommandJournalReader(const CommandJournalReader&) = delete;
+	CommandJournalReader& operator=(const CommandJournalReader&) = delete;
+
+	std::size_t GetRecordCount() const { return m_count; }
+
+	// Pointer to the record of command 'index', straight into the mapping.
+	const JournalRecord* Seek(std::size_t index) const {
+		return m_records + (index < m_count ? index : m_count);
+	}
+
+	/**
+	 * Applies the records [first, last) to 'receivers', which must be indexed
+	 * by the receiver ids the journal was written with.
+	 */
+	void Replay(Player* receivers, std::size_t receiverCount, std::size_t first, std::size_t last) const {
+		if (last > m_count) {
+			last = m_count;
+		}
+		for (const JournalRecord* record = Seek(first), *end = Seek(last); record < end; ++record) {
+			if (record->receiver < receiverCount) {
+				receivers[record->receiver].x += record->dx;
+				receivers[record->receiver].y += record->dy;
+			}
+		}
+	}
+
+private:
+	MappedFile m_file;
+	const JournalRecord* m_records = nullptr;
+	std::size_t m_count = 0;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Player.h"
+
+/**
+ * Command interface.
+ */
+class ICommand {
+public:
+	virtual ~ICommand() = default;
+	virtual void Execute() = 0;
+	virtual void Undo() = 0;
+};
+
+/**
+ * Concrete Command.
+ * The action is stored as a net delta, which lets consecutive moves on the
+ * same receiver be merged into a single command (see 'TryMerge').
+ */
+class MovePlayerCommand : public ICommand {
+public:
+	enum class EAction { Up, Down, Left, Right };
+	MovePlayerCommand(Player& player, EAction action)
+		: m_player(&player)
+		, m_dx(0)
+		, m_dy(0)
+	{
+		switch (action) {
+			case EAction::Up:	m_dy = -1; break;
+			case EAction::Down:	m_dy = 1; break;
+			case EAction::Left:	m_dx = -1; break;
+			case EAction::Right:	m_dx = 1; break;
+			default: break;
+		}
+	}
+	MovePlayerCommand() = delete;
+	virtual ~MovePlayerCommand() = default;
+
+	void Execute() override {
+		m_player->x += m_dx;
+		m_player->y += m_dy;
+	}
+
+	void Undo() override {
+		m_player->x -= m_dx;
+		m_player->y -= m_dy;
+	}
+
+	// Folds 'other' into this command if both target the same receiver.
+	bool TryMerge(const MovePlayerCommand& other) {
+		if (other.m_player != m_player) {
+			return false;
+		}
+		m_dx += other.m_dx;
+		m_dy += other.m_dy;
+		return true;
+	}
+
+	Player& GetReceiver() const { return *m_player; }
+	int GetDeltaX() const { return m_dx; }
+	int GetDeltaY() const { return m_dy; }
+
+private:
+	Player* m_player;
+	int m_dx;
+	int m_dy;
+};
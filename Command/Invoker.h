@@ -0,0 +1,226 @@
+#pragma once
+
+#include "Commands.h"
+#include "CommandJournal.h"
+#include "../Instrumentation/Instrumentation.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Invoker configuration.
+ */
+struct InvokerConfig {
+	// Number of commands between two receiver snapshots. Rewinding to any
+	// index costs at most one snapshot restore plus 'snapshotInterval - 1'
+	// replayed commands. A snapshot restore touches every receiver.
+	std::size_t snapshotInterval = 256;
+
+	// Merge consecutive moves on the same receiver into one net-delta command.
+	bool coalesce = true;
+};
+
+/**
+ * Invoker.
+ * Keeps the command history and a cursor ('position') marking how many of
+ * the commands are currently applied. Every 'snapshotInterval' commands the
+ * receivers are snapshotted, so the history can be rewound to any index
+ * without undoing every command in between.
+ * Most snapshots only hold the receivers changed since the previous one. A
+ * full snapshot of every receiver is taken once the deltas since the last
+ * full one add up to the receiver count, so snapshot memory grows with the
+ * number of commands rather than commands times receivers.
+ * When a journal is attached, every added command is appended to it and
+ * each call to 'Execute' commits the batch.
+ */
+class Invoker {
+public:
+	explicit Invoker(const InvokerConfig& config = InvokerConfig{})
+		: m_config(config)
+	{
+		if (m_config.snapshotInterval == 0) {
+			m_config.snapshotInterval = 1;
+		}
+	}
+
+	// Executes every command that is not yet applied.
+	void Execute() {
+		INSTRUMENT_COUNT(InvokerExecutes, 1);
+		INSTRUMENT_COUNT(InvokerCommandsExecuted, m_commands.size() - m_position);
+		INSTRUMENT_MAX(InvokerHistorySize, m_commands.size());
+
+		while (m_position < m_commands.size()) {
+			Apply();
+		}
+		if (m_journal) {
+			m_journal->Commit();
+		}
+	}
+
+	// Rewinds all the commands.
+	void Undo() {
+		INSTRUMENT_COUNT(InvokerUndos, 1);
+		INSTRUMENT_MAX(InvokerHistorySize, m_commands.size());
+
+		RewindTo(0);
+	}
+
+	// Moves the cursor so that exactly the first 'index' commands are applied.
+	void RewindTo(std::size_t index) {
+		if (index > m_commands.size()) {
+			index = m_commands.size();
+		}
+
+		const std::size_t interval = m_config.snapshotInterval;
+		const std::size_t snapshot = index / interval;
+
+		if (index < m_position) {
+			// Undo directly when that is cheaper than restore + replay.
+			if (m_position - index <= index - snapshot * interval) {
+				while (m_position > index) {
+					m_commands[--m_position].Undo();
+				}
+				return;
+			}
+			Restore(snapshot);
+		}
+		else if (snapshot < m_snapshots.size() && snapshot * interval > m_position) {
+			Restore(snapshot);
+		}
+
+		while (m_position < index) {
+			Apply();
+		}
+	}
+
+	void AddCommand(const MovePlayerCommand& command) {
+		// 'find' first: 'emplace' allocates a node even when the key exists.
+		Player& receiver = command.GetReceiver();
+		auto id = m_receiverIndex.find(&receiver);
+		if (id == m_receiverIndex.end()) {
+			id = m_receiverIndex.emplace(&receiver, m_receivers.size()).first;
+			m_receivers.push_back({ &receiver, receiver });
+			m_lastSnapshotted.push_back(kNever);
+		}
+		if (m_journal) {
+			m_journal->Append(static_cast<std::uint32_t>(id->second), command.GetDeltaX(), command.GetDeltaY());
+		}
+
+		// Only the tail can be merged, and only while it is not applied.
+		if (m_config.coalesce && m_position < m_commands.size() && m_commands.back().TryMerge(command)) {
+			return;
+		}
+		m_commands.emplace_back(command);
+		m_commandReceivers.push_back(static_cast<std::uint32_t>(id->second));
+	}
+
+	// Records added commands to 'journal'. The ids in the journal follow the
+	// order in which receivers were first seen by this Invoker, so a journal
+	// should only be written by one Invoker (see CommandJournal.h).
+	// 'AddCommand' throws std::out_of_range, without adding the command, if
+	// its delta does not fit a journal record.
+	void AttachJournal(CommandJournalWriter* journal) {
+		m_journal = journal;
+	}
+
+	std::size_t GetPosition() const { return m_position; }
+	std::size_t GetHistorySize() const { return m_commands.size(); }
+	std::size_t GetSnapshotCount() const { return m_snapshots.size(); }
+	std::size_t GetReceiverCount() const { return m_receivers.size(); }
+	const InvokerConfig& GetConfig() const { return m_config; }
+
+private:
+	struct Receiver {
+		Player* player;
+		Player initial;	// State before any command in the history touched it.
+	};
+
+	/**
+	 * Receiver states before the command at index 'snapshot * interval'.
+	 * A full snapshot holds every receiver registered at that point, in
+	 * registration order ('receivers' is empty). A delta snapshot holds the
+	 * receivers changed since the previous snapshot, with their ids in
+	 * 'receivers'; 'keyframe' is the full snapshot it builds on.
+	 */
+	struct Snapshot {
+		std::size_t keyframe;
+		std::vector<std::uint32_t> receivers;
+		std::vector<Player> states;
+	};
+
+	static constexpr std::size_t kNever = static_cast<std::size_t>(-1);
+
+	void Apply() {
+		if (m_position % m_config.snapshotInterval == 0 && m_position / m_config.snapshotInterval == m_snapshots.size()) {
+			TakeSnapshot();
+		}
+		m_commands[m_position++].Execute();
+	}
+
+	void TakeSnapshot() {
+		const std::size_t index = m_snapshots.size();
+		Snapshot snapshot;
+
+		// The receivers changed by the commands since the previous snapshot, once each.
+		if (index > 0) {
+			for (std::size_t i = m_position - m_config.snapshotInterval; i < m_position; ++i) {
+				const std::uint32_t receiver = m_commandReceivers[i];
+				if (m_lastSnapshotted[receiver] != index) {
+					m_lastSnapshotted[receiver] = index;
+					snapshot.receivers.push_back(receiver);
+				}
+			}
+		}
+
+		if (index == 0 || m_deltaSinceKeyframe + snapshot.receivers.size() >= m_receivers.size()) {
+			snapshot.keyframe = index;
+			snapshot.receivers.clear();
+			snapshot.states.reserve(m_receivers.size());
+			for (const auto& receiver : m_receivers) {
+				snapshot.states.push_back(*receiver.player);
+			}
+			m_deltaSinceKeyframe = 0;
+		}
+		else {
+			snapshot.keyframe = m_snapshots.back().keyframe;
+			snapshot.states.reserve(snapshot.receivers.size());
+			for (const std::uint32_t receiver : snapshot.receivers) {
+				snapshot.states.push_back(*m_receivers[receiver].player);
+			}
+			m_deltaSinceKeyframe += snapshot.receivers.size();
+		}
+		m_snapshots.emplace_back(std::move(snapshot));
+	}
+
+	void Restore(std::size_t snapshot) {
+		const std::size_t keyframe = m_snapshots[snapshot].keyframe;
+		const std::vector<Player>& states = m_snapshots[keyframe].states;
+		// Receivers registered after the keyframe was taken were untouched at that point.
+		for (std::size_t i = 0; i < m_receivers.size(); ++i) {
+			*m_receivers[i].player = i < states.size() ? states[i] : m_receivers[i].initial;
+		}
+		// The deltas since the keyframe add up to fewer entries than there are receivers.
+		for (std::size_t delta = keyframe + 1; delta <= snapshot; ++delta) {
+			const Snapshot& changes = m_snapshots[delta];
+			for (std::size_t i = 0; i < changes.receivers.size(); ++i) {
+				*m_receivers[changes.receivers[i]].player = changes.states[i];
+			}
+		}
+		m_position = snapshot * m_config.snapshotInterval;
+	}
+
+	InvokerConfig m_config;
+	std::vector<MovePlayerCommand> m_commands;
+	std::vector<std::uint32_t> m_commandReceivers;	// Receiver id of each command.
+	std::size_t m_position = 0;
+
+	std::vector<Receiver> m_receivers;
+	std::unordered_map<Player*, std::size_t> m_receiverIndex;
+	std::vector<Snapshot> m_snapshots;
+	std::vector<std::size_t> m_lastSnapshotted;	// Per receiver: last delta snapshot listing it.
+	std::size_t m_deltaSinceKeyframe = 0;
+
+	CommandJournalWriter* m_journal = nullptr;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Commands.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+	#include <emmintrin.h>
+	#define MOVE_KERNEL_SSE2
+#endif
+
+/**
+ * Batch version of 'MovePlayerCommand' for many entities at once.
+ * Positions are stored as structure-of-arrays ('x[i]', 'y[i]' belong to
+ * entity i) and 'actions[i]' is the encoded 'MovePlayerCommand::EAction'
+ * applied to entity i. Codes outside the enum do nothing, like the default
+ * case of the scalar command. The result is identical to executing one
+ * 'MovePlayerCommand' per entity.
+ */
+namespace MoveKernel {
+
+constexpr std::uint8_t Encode(MovePlayerCommand::EAction action) {
+	return static_cast<std::uint8_t>(action);
+}
+
+// Deltas per action code: Up, Down, Left, Right, then no-ops.
+alignas(32) constexpr std::int32_t kDeltaX[8] = { 0, 0, -1, 1, 0, 0, 0, 0 };
+alignas(32) constexpr std::int32_t kDeltaY[8] = { -1, 1, 0, 0, 0, 0, 0, 0 };
+
+inline const char* GetInstructionSet() {
+#if defined(__AVX2__)
+	return "AVX2";
+#elif defined(MOVE_KERNEL_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+namespace Detail {
+
+// 'Sign' is +1 to execute and -1 to undo.
+template<int Sign>
+inline void ApplyScalar(int* x, int* y, const std::uint8_t* actions, std::size_t begin, std::size_t end) {
+	for (std::size_t i = begin; i < end; ++i) {
+		const std::uint8_t code = actions[i] < 4 ? actions[i] : 4;
+		x[i] += Sign * kDeltaX[code];
+		y[i] += Sign * kDeltaY[code];
+	}
+}
+
+template<int Sign>
+inline void Apply(int* x, int* y, const std::uint8_t* actions, std::size_t count) {
+	std::size_t i = 0;
+
+#if defined(__AVX2__)
+	const __m256i lutX = _mm256_load_si256(reinterpret_cast<const __m256i*>(kDeltaX));
+	const __m256i lutY = _mm256_load_si256(reinterpret_cast<const __m256i*>(kDeltaY));
+	const __m256i noOp = _mm256_set1_epi32(4);
+	for (; i + 8 <= count; i += 8) {
+		const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(actions + i));
+		const __m256i code = _mm256_min_epu32(_mm256_cvtepu8_epi32(packed), noOp);
+		const __m256i dx = _mm256_permutevar8x32_epi32(lutX, code);
+		const __m256i dy = _mm256_permutevar8x32_epi32(lutY, code);
+
+		__m256i* px = reinterpret_cast<__m256i*>(x + i);
+		__m256i* py = reinterpret_cast<__m256i*>(y + i);
+		if (Sign > 0) {
+			_mm256_storeu_si256(px, _mm256_add_epi32(_mm256_loadu_si256(px), dx));
+			_mm256_storeu_si256(py, _mm256_add_epi32(_mm256_loadu_si256(py), dy));
+		}
+		else {
+			_mm256_storeu_si256(px, _mm256_sub_epi32(_mm256_loadu_si256(px), dx));
+			_mm256_storeu_si256(py, _mm256_sub_epi32(_mm256_loadu_si256(py), dy));
+		}
+	}
+#elif defined(MOVE_KERNEL_SSE2)
+	// Without a variable permute the table is expressed as compares:
+	// dx = [Left] - [Right] and dy = [Up] - [Down] on all-ones masks.
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i up = _mm_set1_epi32(Encode(MovePlayerCommand::EAction::Up));
+	const __m128i down = _mm_set1_epi32(Encode(MovePlayerCommand::EAction::Down));
+	const __m128i left = _mm_set1_epi32(Encode(MovePlayerCommand::EAction::Left));
+	const __m128i right = _mm_set1_epi32(Encode(MovePlayerCommand::EAction::Right));
+	for (; i + 4 <= count; i += 4) {
+		std::int32_t word;
+		std::memcpy(&word, actions + i, sizeof(word));
+		const __m128i bytes = _mm_cvtsi32_si128(word);
+		const __m128i code = _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero);
+		const __m128i dx = _mm_sub_epi32(_mm_cmpeq_epi32(code, left), _mm_cmpeq_epi32(code, right));
+		const __m128i dy = _mm_sub_epi32(_mm_cmpeq_epi32(code, up), _mm_cmpeq_epi32(code, down));
+
+		__m128i* px = reinterpret_cast<__m128i*>(x + i);
+		__m128i* py = reinterpret_cast<__m128i*>(y + i);
+		if (Sign > 0) {
+			_mm_storeu_si128(px, _mm_add_epi32(_mm_loadu_si128(px), dx));
+			_mm_storeu_si128(py, _mm_add_epi32(_mm_loadu_si128(py), dy));
+		}
+		else {
+			_mm_storeu_si128(px, _mm_sub_epi32(_mm_loadu_si128(px), dx));
+			_mm_storeu_si128(py, _mm_sub_epi32(_mm_loadu_si128(py), dy));
+		}
+	}
+#endif
+
+	ApplyScalar<Sign>(x, y, actions, i, count);
+}
+
+} // namespace Detail
+
+// Executes 'actions[i]' on entity i, for i in [0, count).
+inline void Execute(int* x, int* y, const std::uint8_t* actions, std::size_t count) {
+	Detail::Apply<1>(x, y, actions, count);
+}
+
+// Reverts 'Execute' for the same block of actions.
+inline void Undo(int* x, int* y, const std::uint8_t* actions, std::size_t count) {
+	Detail::Apply<-1>(x, y, actions, count);
+}
+
+} // namespace MoveKernel
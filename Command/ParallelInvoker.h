@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Commands.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Parallel Invoker.
+ * Commands on different receivers are independent, so the batch is
+ * partitioned by receiver and the partitions are executed concurrently on a
+ * work-stealing pool. Commands on the same receiver keep their order.
+ * Unlike 'Invoker' no history is kept beyond the current batch. The batch
+ * is a task group of its own, so several ParallelInvokers can share a pool.
+ */
+class ParallelInvoker {
+public:
+	explicit ParallelInvoker(ThreadPool& pool)
+		: m_pool(pool)
+	{
+	}
+
+	void AddCommand(const MovePlayerCommand& command) {
+		Player* receiver = &command.GetReceiver();
+		auto partition = m_partitionIndex.find(receiver);
+		if (partition == m_partitionIndex.end()) {
+			partition = m_partitionIndex.emplace(receiver, m_partitionCount).first;
+			if (m_partitionCount == m_partitions.size()) {
+				m_partitions.emplace_back();
+			}
+			++m_partitionCount;
+		}
+		m_partitions[partition->second].emplace_back(command);
+	}
+
+	// Starts executing the batch. Must be followed by 'Wait'.
+	void Submit() {
+		Dispatch([](std::vector<MovePlayerCommand>& commands) {
+			for (auto cmd = commands.begin(); cmd != commands.end(); ++cmd) {
+				cmd->Execute();
+			}
+		});
+	}
+
+	// Starts undoing the batch. Must be followed by 'Wait'.
+	void SubmitUndo() {
+		Dispatch([](std::vector<MovePlayerCommand>& commands) {
+			for (auto cmd = commands.rbegin(); cmd != commands.rend(); ++cmd) {
+				cmd->Undo();
+			}
+		});
+	}
+
+	// Barrier: returns once every partition of this batch is done, whatever
+	// else runs on the pool.
+	void Wait() {
+		m_pool.Wait(m_batch);
+	}
+
+	void Execute() {
+		Submit();
+		Wait();
+	}
+
+	void Undo() {
+		SubmitUndo();
+		Wait();
+	}
+
+	// Starts a new batch. The partition buffers are kept for reuse.
+	void Clear() {
+		for (std::size_t i = 0; i < m_partitionCount; ++i) {
+			m_partitions[i].clear();
+		}
+		m_partitionIndex.clear();
+		m_partitionCount = 0;
+	}
+
+	std::size_t GetPartitionCount() const { return m_partitionCount; }
+
+	// The batch's commands on 'receiver', in the order they are executed.
+	const std::vector<MovePlayerCommand>& GetCommands(const Player& receiver) const {
+		static const std::vector<MovePlayerCommand> kNone;
+		const auto partition = m_partitionIndex.find(const_cast<Player*>(&receiver));
+		return partition != m_partitionIndex.end() ? m_partitions[partition->second] : kNone;
+	}
+
+private:
+	template<typename Func>
+	void Dispatch(Func func) {
+		// A few tasks per thread leaves room for stealing without paying
+		// a task per receiver.
+		const std::size_t taskCount = std::min(m_partitionCount, m_pool.GetThreadCount() * 4);
+		for (std::size_t task = 0; task < taskCount; ++task) {
+			const std::size_t first = m_partitionCount * task / taskCount;
+			const std::size_t last = m_partitionCount * (task + 1) / taskCount;
+			m_pool.Submit(m_batch, [this, func, first, last] {
+				for (std::size_t i = first; i < last; ++i) {
+					func(m_partitions[i]);
+				}
+			});
+		}
+	}
+
+	ThreadPool& m_pool;
+	ThreadPool::TaskGroup m_batch;
+	std::vector<std::vector<MovePlayerCommand>> m_partitions;
+	std::size_t m_partitionCount = 0;
+	std::unordered_map<Player*, std::size_t> m_partitionIndex;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <iostream>
+
+/**
+ * Receiver.
+ */
+class Player {
+public:
+	int x;
+	int y;
+
+	friend std::ostream& operator<<(std::ostream& os, const Player& player) {
+		os << "(" << player.x << ", " << player.y << ")";
+		return os;
+	}
+};
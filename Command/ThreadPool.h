@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Work-stealing thread pool.
+ * Every worker owns a task queue; it pops work from the back of its own
+ * queue and, when that runs dry, steals from the front of the others.
+ * 'Wait' is the barrier that ends a batch of submitted tasks. Tasks can
+ * also be submitted to a 'TaskGroup' and waited for as a group, so several
+ * users can share one pool without waiting for each other's batches.
+ */
+class ThreadPool {
+public:
+	using Task = std::function<void()>;
+
+	// Counts the unfinished tasks of one batch.
+	struct TaskGroup {
+		std::atomic<std::size_t> pending{ 0 };
+	};
+
+	explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency())
+	{
+		if (threadCount == 0) {
+			threadCount = 1;
+		}
+		for (std::size_t i = 0; i < threadCount; ++i) {
+			m_queues.emplace_back(std::make_unique<WorkQueue>());
+		}
+		for (std::size_t i = 0; i < threadCount; ++i) {
+			m_workers.emplace_back([this, i] { WorkerLoop(i); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_wake.notify_all();
+		for (auto& worker : m_workers) {
+			worker.join();
+		}
+	}
+
+	void Submit(Task task) {
+		Push(std::move(task), nullptr);
+	}
+
+	void Submit(TaskGroup& group, Task task) {
+		group.pending.fetch_add(1, std::memory_order_relaxed);
+		Push(std::move(task), &group);
+	}
+
+	// Blocks until every submitted task has finished.
+	void Wait() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_idle.wait(lock, [this] { return m_pending.load(std::memory_order_acquire) == 0; });
+	}
+
+	// Blocks until every task submitted to 'group' has finished.
+	void Wait(const TaskGroup& group) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_idle.wait(lock, [&group] { return group.pending.load(std::memory_order_acquire) == 0; });
+	}
+
+	std::size_t GetThreadCount() const { return m_workers.size(); }
+
+private:
+	struct QueuedTask {
+		Task task;
+		TaskGroup* group;
+	};
+
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<QueuedTask> tasks;
+	};
+
+	void Push(Task task, TaskGroup* group) {
+		const std::size_t queue = m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+		m_pending.fetch_add(1, std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+			m_queues[queue]->tasks.push_back({ std::move(task), group });
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			++m_generation;
+		}
+		m_wake.notify_one();
+	}
+
+	bool TryPop(std::size_t self, QueuedTask& task) {
+		{
+			WorkQueue& own = *m_queues[self];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (!own.tasks.empty()) {
+				task = std::move(own.tasks.back());
+				own.tasks.pop_back();
+				return true;
+			}
+		}
+		for (std::size_t i = 1; i < m_queues.size(); ++i) {
+			WorkQueue& victim = *m_queues[(self + i) % m_queues.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.tasks.empty()) {
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void WorkerLoop(std::size_t self) {
+		QueuedTask task{};
+		for (;;) {
+			std::size_t generation;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				generation = m_generation;
+			}
+
+			while (TryPop(self, task)) {
+				task.task();
+				task.task = nullptr;
+				// Both counters reach zero before waiters are woken.
+				const bool groupDone = task.group && task.group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+				const bool poolDone = m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+				if (groupDone || poolDone) {
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_idle.notify_all();
+				}
+			}
+
+			// Sleep until something was submitted since the queues were scanned.
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [&] { return m_stopping || m_generation != generation; });
+			if (m_stopping) {
+				return;
+			}
+		}
+	}
+
+	std::vector<std::unique_ptr<WorkQueue>> m_queues;
+	std::vector<std::thread> m_workers;
+	std::atomic<std::size_t> m_next{ 0 };
+	std::atomic<std::size_t> m_pending{ 0 };
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_idle;
+	std::size_t m_generation = 0;
+	bool m_stopping = false;
+};
@@ -0,0 +1,41 @@
+#include "Invoker.h"
+#include "MoveKernel.h"
+#include "../TestSupport/AllocationTracker.h"
+
+#include <vector>
+
+
+TEST(Command, RewindingDoesNotAllocate) {
+	Player player{ 0, 0 };
+	Invoker invoker{ InvokerConfig{ 4, false } };
+	for (int i = 0; i < 64; ++i) {
+		invoker.AddCommand(MovePlayerCommand{ player, static_cast<MovePlayerCommand::EAction>(i % 3) });
+	}
+	invoker.Execute();
+
+	// The snapshots exist now, so moving around the history is allocation free.
+	EXPECT_NO_ALLOCATIONS(invoker.Undo());
+	EXPECT_TRUE(player.x == 0 && player.y == 0);
+	EXPECT_NO_ALLOCATIONS(invoker.Execute());
+	EXPECT_NO_ALLOCATIONS(invoker.RewindTo(17));
+	EXPECT_NO_ALLOCATIONS(invoker.RewindTo(50));
+}
+
+TEST(Command, CoalescedCommandDoesNotAllocate) {
+	Player player{ 0, 0 };
+	Invoker invoker{ };
+	invoker.AddCommand(MovePlayerCommand{ player, MovePlayerCommand::EAction::Up });
+
+	EXPECT_NO_ALLOCATIONS(invoker.AddCommand(MovePlayerCommand{ player, MovePlayerCommand::EAction::Left }));
+	EXPECT_TRUE(invoker.GetHistorySize() == 1);
+}
+
+TEST(Command, MoveKernelDoesNotAllocate) {
+	std::vector<std::uint8_t> actions(1000, MoveKernel::Encode(MovePlayerCommand::EAction::Right));
+	std::vector<int> x(actions.size(), 0);
+	std::vector<int> y(actions.size(), 0);
+
+	EXPECT_NO_ALLOCATIONS(MoveKernel::Execute(x.data(), y.data(), actions.data(), actions.size()));
+	EXPECT_NO_ALLOCATIONS(MoveKernel::Undo(x.data(), y.data(), actions.data(), actions.size()));
+	EXPECT_TRUE(x[999] == 0);
+}
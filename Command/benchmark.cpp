@@ -0,0 +1,251 @@
+/*
+	Benchmarks for the Command demo.
+	Times the Invoker and batch kernel hot paths with the shared harness, then
+	measures the latency of 'Invoker::RewindTo' against the history length,
+	with and without receiver snapshots, and the write and replay throughput
+	of the command journal, serial versus partitioned parallel execution, and
+	the batch move kernel against one 'MovePlayerCommand' per entity.
+
+	Updated: 2026-10-19
+	Author: Jonathan Helsing [github.com/Jonathan-source]
+*/
+
+#include "Invoker.h"
+#include "MoveKernel.h"
+#include "ParallelInvoker.h"
+#include "../Benchmarks/Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void RunHotPaths(BenchmarkSuite& suite)
+{
+	std::mt19937 rng{ 42 };
+	std::vector<Player> players(8, Player{ 0, 0 });
+	Invoker invoker{ InvokerConfig{ 256, false } };
+	for (std::size_t i = 0; i < 1024; ++i) {
+		const auto action = static_cast<MovePlayerCommand::EAction>(rng() % 4);
+		invoker.AddCommand(MovePlayerCommand{ players[rng() % players.size()], action });
+	}
+
+	suite.Run("Invoker::Execute+Undo/1024", [&] {
+		invoker.Execute();
+		invoker.Undo();
+	});
+
+	invoker.Execute();
+	suite.Run("Invoker::RewindTo (random index)/1024", [&] {
+		invoker.RewindTo(rng() % 1025);
+	});
+
+	std::vector<std::uint8_t> actions(4096);
+	for (auto& action : actions) {
+		action = static_cast<std::uint8_t>(rng() % 4);
+	}
+	std::vector<int> x(actions.size(), 0);
+	std::vector<int> y(actions.size(), 0);
+	suite.Run(std::string("MoveKernel::Execute/4096 (") + MoveKernel::GetInstructionSet() + ")", [&] {
+		MoveKernel::Execute(x.data(), y.data(), actions.data(), actions.size());
+		DoNotOptimize(x.data());
+	});
+}
+
+// Median latency (ns) of rewinding a fully executed history of 'length'
+// commands to random indices.
+double MeasureRewind(std::size_t length, std::size_t snapshotInterval, std::size_t samples)
+{
+	std::vector<Player> players(8, Player{ 0, 0 });
+	Invoker invoker{ InvokerConfig{ snapshotInterval, false } };
+
+	std::mt19937 rng{ 42 };
+	for (std::size_t i = 0; i < length; ++i) {
+		const auto action = static_cast<MovePlayerCommand::EAction>(rng() % 4);
+		invoker.AddCommand(MovePlayerCommand{ players[rng() % players.size()], action });
+	}
+	invoker.Execute();
+
+	std::uniform_int_distribution<std::size_t> target{ 0, length };
+	std::vector<double> timings;
+	timings.reserve(samples);
+	for (std::size_t i = 0; i < samples; ++i) {
+		const std::size_t index = target(rng);
+		const auto start = Clock::now();
+		invoker.RewindTo(index);
+		timings.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+
+		// Return to the end of the history, untimed.
+		invoker.Execute();
+	}
+
+	std::nth_element(timings.begin(), timings.begin() + timings.size() / 2, timings.end());
+	return timings[timings.size() / 2];
+}
+
+// Writes 'count' commands to a journal, then replays it from the mapping.
+void MeasureJournal(const char* path, std::size_t count)
+{
+	std::remove(path);
+
+	constexpr std::size_t kReceivers = 1024;
+	std::mt19937 rng{ 42 };
+
+	auto start = Clock::now();
+	{
+		CommandJournalWriter journal{ path };
+		for (std::size_t i = 0; i < count; ++i) {
+			const int axis = rng() & 1;
+			const int step = (rng() & 2) ? 1 : -1;
+			journal.Append(static_cast<std::uint32_t>(rng() % kReceivers), axis ? step : 0, axis ? 0 : step);
+		}
+		journal.Commit();
+	}
+	const double writeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::vector<Player> players(kReceivers, Player{ 0, 0 });
+	start = Clock::now();
+	CommandJournalReader reader{ path };
+	reader.Replay(players.data(), players.size(), 0, reader.GetRecordCount());
+	const double replaySeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	long long checksum = 0;
+	for (const auto& player : players) {
+		checksum += player.x * 31LL + player.y;
+	}
+
+	std::printf("journal: %zu commands, write %.3f s, replay %.3f s (%.0f M commands/s, checksum %lld)\n",
+		reader.GetRecordCount(), writeSeconds, replaySeconds,
+		reader.GetRecordCount() / replaySeconds / 1e6, checksum);
+
+	std::remove(path);
+}
+
+// One tick: 'commandsPerReceiver' commands for each of 'receivers' players.
+void MeasureParallel(std::size_t receivers, std::size_t commandsPerReceiver)
+{
+	std::vector<Player> players(receivers, Player{ 0, 0 });
+	std::vector<MovePlayerCommand> commands;
+	commands.reserve(receivers * commandsPerReceiver);
+	std::mt19937 rng{ 42 };
+	for (std::size_t i = 0; i < receivers * commandsPerReceiver; ++i) {
+		const auto action = static_cast<MovePlayerCommand::EAction>(rng() % 4);
+		commands.emplace_back(players[rng() % receivers], action);
+	}
+
+	Invoker serial{ InvokerConfig{ std::numeric_limits<std::size_t>::max(), false } };
+	for (const auto& cmd : commands) {
+		serial.AddCommand(cmd);
+	}
+	auto start = Clock::now();
+	serial.Execute();
+	const double serialSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	ThreadPool pool;
+	ParallelInvoker parallel{ pool };
+	for (const auto& cmd : commands) {
+		parallel.AddCommand(cmd);
+	}
+	start = Clock::now();
+	parallel.Execute();
+	const double parallelSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::printf("execute: %zu receivers x %zu commands, serial %.2f ms, parallel %.2f ms on %zu threads\n",
+		receivers, commandsPerReceiver, serialSeconds * 1e3, parallelSeconds * 1e3, pool.GetThreadCount());
+}
+
+// Applies one move to each of 'count' entities, scalar commands versus the
+// structure-of-arrays kernel. Returns false if the results differ.
+bool MeasureMoveKernel(std::size_t count)
+{
+	std::vector<std::uint8_t> actions(count);
+	std::mt19937 rng{ 42 };
+	for (auto& action : actions) {
+		action = static_cast<std::uint8_t>(rng() % 4);
+	}
+
+	std::vector<Player> players(count, Player{ 0, 0 });
+	auto start = Clock::now();
+	for (std::size_t i = 0; i < count; ++i) {
+		MovePlayerCommand{ players[i], static_cast<MovePlayerCommand::EAction>(actions[i]) }.Execute();
+	}
+	const double scalarSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::vector<int> x(count, 0);
+	std::vector<int> y(count, 0);
+	start = Clock::now();
+	MoveKernel::Execute(x.data(), y.data(), actions.data(), count);
+	const double kernelSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	bool identical = true;
+	for (std::size_t i = 0; i < count; ++i) {
+		identical = identical && x[i] == players[i].x && y[i] == players[i].y;
+	}
+
+	start = Clock::now();
+	MoveKernel::Undo(x.data(), y.data(), actions.data(), count);
+	const double undoSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	for (std::size_t i = 0; i < count; ++i) {
+		identical = identical && x[i] == 0 && y[i] == 0;
+	}
+
+	std::printf("move kernel (%s): %zu commands, scalar %.0f M/s, batch execute %.0f M/s, batch undo %.0f M/s, %s\n",
+		MoveKernel::GetInstructionSet(), count, count / scalarSeconds / 1e6, count / kernelSeconds / 1e6,
+		count / undoSeconds / 1e6, identical ? "identical" : "MISMATCH");
+	return identical;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+	const BenchmarkOptions options = ParseBenchmarkOptions(argc, argv);
+	BenchmarkSuite suite{ options };
+	suite.PrintHeader();
+	RunHotPaths(suite);
+
+	// The scenarios below are skipped when only some benchmarks are selected.
+	if (!options.filter.empty()) {
+		return suite.Finish();
+	}
+	std::printf("\n");
+
+	constexpr std::size_t kNoSnapshots = std::numeric_limits<std::size_t>::max();
+	const std::size_t lengths[] = { 1000, 10000, 100000, 1000000 };
+
+	std::printf("%-12s %18s %18s\n", "history", "no snapshots (ns)", "interval 256 (ns)");
+	for (const std::size_t length : lengths) {
+		const std::size_t samples = length >= 1000000 ? 25 : 200;
+		std::printf("%-12zu %18.0f %18.0f\n", length,
+			MeasureRewind(length, kNoSnapshots, samples),
+			MeasureRewind(length, 256, samples));
+	}
+
+	// '--journal-commands <n>' overrides the journal size, e.g. 100000000.
+	std::size_t journalCommands = 10000000;
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (std::strcmp(argv[i], "--journal-commands") == 0) {
+			journalCommands = std::strtoull(argv[i + 1], nullptr, 10);
+		}
+	}
+	MeasureJournal("command_journal.bin", journalCommands);
+
+	MeasureParallel(10000, 100);
+
+	if (!MeasureMoveKernel(10000000)) {
+		std::fprintf(stderr, "MoveKernel and MovePlayerCommand disagree\n");
+		return 1;
+	}
+
+	return suite.Finish();
+}
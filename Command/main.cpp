@@ -6,107 +6,24 @@
 	the Invoker without knowing the details of the action that is performed.
 	All the information required for executing the action is stored in the concrete
 	command	object. 
+	Consecutive moves on the same receiver are coalesced into one net-delta
+	command, and the Invoker snapshots the receivers periodically so the
+	history can be rewound to any command index cheaply.
 
-	Updated: 2022-06-06
+	Updated: 2026-10-19
 	Author: Jonathan Helsing [github.com/Jonathan-source]
 */
 
+#include "Invoker.h"
+
 #include <iostream>
 #include <vector>
 
-/**
- * Receiver.
- */
-class Player {
-public:
-	int x;
-	int y;
-
-	friend std::ostream& operator<<(std::ostream& os, const Player& player) {
-		os << "(" << player.x << ", " << player.y << ")";
-		return os;
-	}
-};
-
-/**
- * Command interface.
- */
-class ICommand {
-public:
-	virtual ~ICommand() = default;
-	virtual void Execute() = 0;
-	virtual void Undo() = 0;
-};
-
-/**
- * Concrete Command.
- */
-class MovePlayerCommand : public ICommand {
-public:
-	enum class EAction { Up, Down, Left, Right };
-	MovePlayerCommand(Player& player, EAction action)
-		: m_player(player)
-		, m_action(action)
-	{
-	}
-	MovePlayerCommand() = delete;
-	virtual ~MovePlayerCommand() = default;
-
-	void Execute() override {
-		switch (m_action) {
-			case EAction::Up:	m_player.y -= 1; break;
-			case EAction::Down:	m_player.y += 1; break;
-			case EAction::Left:	m_player.x -= 1; break;
-			case EAction::Right:	m_player.x += 1; break;
-			default: break;
-		}
-	}
-
-	void Undo() override {
-		switch (m_action) {
-			case EAction::Up:	m_player.y += 1; break;
-			case EAction::Down:	m_player.y -= 1; break;
-			case EAction::Left:	m_player.x += 1; break;
-			case EAction::Right:	m_player.x -= 1; break;
-			default: break;
-		}
-	}
-
-private:
-	Player& m_player;
-	EAction m_action;
-};
-
-/**
- * Invoker.
- */
-class Invoker {
-public:
-	void Execute() {
-		for (auto cmd = m_commands.begin(); cmd != m_commands.end(); ++cmd) { 
-			cmd->Execute(); 
-		}
-	}
-
-	void Undo() {
-		for (auto cmd = m_commands.rbegin(); cmd != m_commands.rend(); ++cmd) { 
-			cmd->Undo(); 
-		}
-	}
-
-	void AddCommand(const MovePlayerCommand& command) {
-		m_commands.emplace_back(command);
-	}
-
-private:
-	std::vector<MovePlayerCommand> m_commands;
-};
-
 
 int main()
 {
 	Player player{ 0,0 };
-	Invoker invoker{ };
+	Invoker invoker{ InvokerConfig{ 2, false } };
 
 	std::vector<MovePlayerCommand> commands {
 		MovePlayerCommand{ player, MovePlayerCommand::EAction::Up},
@@ -128,10 +45,19 @@ int main()
 
 	std::cout << "Player is currently at " << player << "\n\n";
 
+	std::cout << "Rewind to command 1:\n";
+	invoker.RewindTo(1);
+
+	std::cout << "Player is currently at " << player << "\n\n";
+
 	std::cout << "\nUndo commands:\n";
 	invoker.Undo();
 
 	std::cout << "Player is currently at " << player << "\n\n";
 
+	if (Instrumentation::kEnabled) {
+		std::cout << "Instrumentation:\n" << Instrumentation::TakeSnapshot();
+	}
+
 	return 0;
 }
@@ -0,0 +1,286 @@
+#include "Invoker.h"
+#include "MoveKernel.h"
+#include "ParallelInvoker.h"
+#include "../TestSupport/AllocationTracker.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+constexpr std::size_t kReceivers = 4;
+
+bool SamePositions(const std::vector<Player>& a, const std::vector<Player>& b) {
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		if (a[i].x != b[i].x || a[i].y != b[i].y) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Per instruction set, since the tests are also built with AVX2 enabled.
+const std::string kJournalPath = std::string("CommandTests.") + MoveKernel::GetInstructionSet() + ".journal";
+
+} // namespace
+
+
+// Random mixes of AddCommand/Execute/RewindTo must leave the receivers exactly
+// where an Invoker with a single snapshot (replaying everything) leaves them.
+TEST(Invoker, SnapshotsMatchFullReplay) {
+	std::mt19937 rng{ 26 };
+	std::size_t mismatches = 0;
+	for (int trial = 0; trial < 1000 && mismatches == 0; ++trial) {
+		for (std::size_t interval = 1; interval <= 5; ++interval) {
+			for (const bool coalesce : { false, true }) {
+				std::vector<Player> players(kReceivers, Player{ 0, 0 });
+				std::vector<Player> reference(kReceivers, Player{ 0, 0 });
+				Invoker invoker{ InvokerConfig{ interval, coalesce } };
+				Invoker replay{ InvokerConfig{ SIZE_MAX, coalesce } };
+
+				for (int step = 0; step < 64; ++step) {
+					const unsigned operation = rng() % 4;
+					if (operation < 2) {
+						const std::size_t receiver = rng() % kReceivers;
+						const auto action = static_cast<MovePlayerCommand::EAction>(rng() % 4);
+						invoker.AddCommand(MovePlayerCommand{ players[receiver], action });
+						replay.AddCommand(MovePlayerCommand{ reference[receiver], action });
+					}
+					else if (operation == 2) {
+						invoker.Execute();
+						replay.Execute();
+					}
+					else {
+						// Also past the end, which clamps.
+						const std::size_t index = rng() % (invoker.GetHistorySize() + 2);
+						invoker.RewindTo(index);
+						replay.RewindTo(index);
+					}
+
+					if (invoker.GetPosition() != replay.GetPosition()
+						|| invoker.GetHistorySize() != replay.GetHistorySize()
+						|| !SamePositions(players, reference)) {
+						++mismatches;
+						break;
+					}
+				}
+			}
+		}
+	}
+	EXPECT_TRUE(mismatches == 0);
+}
+
+TEST(Invoker, UndoRestoresTheInitialPositions) {
+	std::vector<Player> players{ { 3, -2 }, { 0, 0 }, { -7, 5 } };
+	const std::vector<Player> initial = players;
+	Invoker invoker{ InvokerConfig{ 3, false } };
+	for (int i = 0; i < 50; ++i) {
+		invoker.AddCommand(MovePlayerCommand{ players[i % 3], static_cast<MovePlayerCommand::EAction>(i % 4) });
+	}
+	invoker.Execute();
+	invoker.Undo();
+
+	EXPECT_TRUE(invoker.GetPosition() == 0);
+	EXPECT_TRUE(SamePositions(players, initial));
+}
+
+TEST(ParallelInvoker, KeepsPerReceiverOrder) {
+	std::mt19937 rng{ 28 };
+	std::vector<Player> players(8, Player{ 0, 0 });
+	std::vector<Player> expected = players;
+	std::vector<std::vector<MovePlayerCommand::EAction>> added(players.size());
+
+	ThreadPool pool{ 4 };
+	ParallelInvoker invoker{ pool };
+	for (int i = 0; i < 1000; ++i) {
+		const std::size_t receiver = rng() % players.size();
+		const auto action = static_cast<MovePlayerCommand::EAction>(rng() % 4);
+		invoker.AddCommand(MovePlayerCommand{ players[receiver], action });
+		MovePlayerCommand{ expected[receiver], action }.Execute();
+		added[receiver].push_back(action);
+	}
+
+	bool ordered = invoker.GetPartitionCount() == players.size();
+	for (std::size_t receiver = 0; receiver < players.size(); ++receiver) {
+		const auto& commands = invoker.GetCommands(players[receiver]);
+		ordered = ordered && commands.size() == added[receiver].size();
+		for (std::size_t i = 0; ordered && i < commands.size(); ++i) {
+			const MovePlayerCommand reference{ players[receiver], added[receiver][i] };
+			ordered = commands[i].GetDeltaX() == reference.GetDeltaX() && commands[i].GetDeltaY() == reference.GetDeltaY();
+		}
+	}
+	EXPECT_TRUE(ordered);
+
+	invoker.Execute();
+	EXPECT_TRUE(SamePositions(players, expected));
+}
+
+TEST(ParallelInvoker, UndoReturnsToTheStartPositions) {
+	std::vector<Player> players{ { 1, 1 }, { -4, 2 }, { 0, 9 } };
+	const std::vector<Player> start = players;
+
+	ThreadPool pool{ 2 };
+	ParallelInvoker invoker{ pool };
+	for (int i = 0; i < 300; ++i) {
+		invoker.AddCommand(MovePlayerCommand{ players[i % 3], i % 2 ? MovePlayerCommand::EAction::Right : MovePlayerCommand::EAction::Down });
+	}
+	invoker.Execute();
+	EXPECT_TRUE(!SamePositions(players, start));
+	invoker.Undo();
+	EXPECT_TRUE(SamePositions(players, start));
+}
+
+TEST(ParallelInvoker, WaitOnlyWaitsForItsOwnBatch) {
+	ThreadPool pool{ 2 };
+
+	// Another user of the pool keeps one of its tasks running.
+	std::atomic<bool> release{ false };
+	std::atomic<bool> otherDone{ false };
+	pool.Submit([&] {
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (!release.load() && std::chrono::steady_clock::now() < deadline) {
+			std::this_thread::yield();
+		}
+		otherDone = true;
+	});
+
+	Player player{ 0, 0 };
+	ParallelInvoker invoker{ pool };
+	invoker.AddCommand(MovePlayerCommand{ player, MovePlayerCommand::EAction::Right });
+	invoker.Execute();
+
+	EXPECT_TRUE(!otherDone.load());
+	EXPECT_TRUE(player.x == 1);
+	release = true;
+	pool.Wait();
+}
+
+// Every action code, on lengths that leave a scalar tail after the vector loop.
+TEST(MoveKernel, MatchesMovePlayerCommand) {
+	std::mt19937 rng{ 29 };
+	bool identical = true;
+	for (std::size_t count = 0; count <= 259 && identical; ++count) {
+		std::vector<std::uint8_t> actions(count);
+		std::vector<int> x(count);
+		std::vector<int> y(count);
+		std::vector<Player> players(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			actions[i] = static_cast<std::uint8_t>((i + count) % 256);
+			x[i] = players[i].x = static_cast<int>(rng() % 2001) - 1000;
+			y[i] = players[i].y = static_cast<int>(rng() % 2001) - 1000;
+		}
+		const std::vector<int> startX = x;
+		const std::vector<int> startY = y;
+
+		MoveKernel::Execute(x.data(), y.data(), actions.data(), count);
+		for (std::size_t i = 0; i < count; ++i) {
+			MovePlayerCommand{ players[i], static_cast<MovePlayerCommand::EAction>(actions[i]) }.Execute();
+			identical = identical && x[i] == players[i].x && y[i] == players[i].y;
+		}
+
+		MoveKernel::Undo(x.data(), y.data(), actions.data(), count);
+		identical = identical && x == startX && y == startY;
+	}
+	EXPECT_TRUE(identical);
+}
+
+TEST(CommandJournal, ReopeningDropsATornRecord) {
+	const char* path = kJournalPath.c_str();
+	std::remove(path);
+	{
+		CommandJournalWriter journal{ path };
+		for (int i = 0; i < 10; ++i) {
+			journal.Append(0, 1, 0);
+		}
+		journal.Commit();
+	}
+	// Cut the last record short, as a crash in the middle of a write would.
+	{
+		std::ifstream in{ path, std::ios::binary };
+		std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		bytes.resize(bytes.size() - 3);
+		std::ofstream{ path, std::ios::binary | std::ios::trunc }.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+	{
+		CommandJournalWriter journal{ path };
+		journal.Append(0, 0, 1);
+		journal.Commit();
+	}
+
+	const CommandJournalReader reader{ path };
+	Player player{ 0, 0 };
+	reader.Replay(&player, 1, 0, reader.GetRecordCount());
+	EXPECT_TRUE(reader.GetRecordCount() == 10);
+	EXPECT_TRUE(player.x == 9 && player.y == 1);
+	std::remove(path);
+}
+
+TEST(CommandJournal, ReplayingUpToThePositionGivesTheRewoundState) {
+	const char* path = kJournalPath.c_str();
+	std::remove(path);
+	Player player{ 0, 0 };
+	std::size_t position = 0;
+	{
+		CommandJournalWriter journal{ path };
+		Invoker invoker{ InvokerConfig{ 4, false } };
+		invoker.AttachJournal(&journal);
+		for (int i = 0; i < 20; ++i) {
+			invoker.AddCommand(MovePlayerCommand{ player, MovePlayerCommand::EAction::Right });
+		}
+		invoker.Execute();
+		invoker.RewindTo(7);
+		position = invoker.GetPosition();
+	}
+
+	// The journal has every command; the cursor is the caller's to keep.
+	const CommandJournalReader reader{ path };
+	Player replayed{ 0, 0 };
+	reader.Replay(&replayed, 1, 0, position);
+	EXPECT_TRUE(reader.GetRecordCount() == 20);
+	EXPECT_TRUE(replayed.x == player.x && replayed.y == player.y);
+	std::remove(path);
+}
+
+TEST(CommandJournal, OversizedDeltaIsRejected) {
+	const char* path = kJournalPath.c_str();
+	std::remove(path);
+	{
+		CommandJournalWriter journal{ path };
+		bool thrown = false;
+		try {
+			journal.Append(0, 40000, 0);
+		}
+		catch (const std::out_of_range&) {
+			thrown = true;
+		}
+		EXPECT_TRUE(thrown);
+	}
+	std::remove(path);
+}
+
+#if defined(__linux__)
+TEST(CommandJournal, CommitReportsWriteErrors) {
+	// Every write to /dev/full fails with ENOSPC once stdio flushes it.
+	CommandJournalWriter journal{ "/dev/full" };
+	journal.Append(0, 1, 0);
+	bool thrown = false;
+	try {
+		journal.Commit();
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+	EXPECT_TRUE(thrown);
+}
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * The object/decorator in which the function will be wrapped into.
+ */
+template<typename R, typename... Args>
+class FuncLogger {
+public:
+	FuncLogger(const std::function<R(Args...)>& func)
+		: m_func(func)
+		, m_records()
+	{
+	}
+
+	R operator() (Args... args) {
+		const auto start = std::chrono::steady_clock::now();
+
+		R result = m_func(args...);
+
+		const auto duration{ std::chrono::steady_clock::now() - start };
+		m_records.emplace_back(duration);
+
+		return result;
+	}
+
+	// Makes room for 'count' more records, so that many calls do not allocate.
+	void Reserve(std::size_t count) {
+		m_records.reserve(m_records.size() + count);
+	}
+
+	std::vector<std::chrono::nanoseconds> GetRecords() const {
+		return m_records;
+	}
+
+private:
+	std::function<R(Args...)> m_func;
+	std::vector<std::chrono::nanoseconds> m_records;
+};
+
+// Utility function for creating the 'FuncLogger' class.
+template<typename R, typename... Args>
+auto CreateFuncLogger(R(*func)(Args...)) {
+	return FuncLogger<R, Args...>(std::function<R(Args...)>(func));
+}
@@ -0,0 +1,16 @@
+#include "FuncLogger.h"
+#include "../TestSupport/AllocationTracker.h"
+
+int Add(int a, int b, int c) {
+	return a + b + c;
+}
+
+
+TEST(Decorator, LoggedCallDoesNotAllocateWithReservedRecords) {
+	auto logged_Add{ CreateFuncLogger(Add) };
+	logged_Add.Reserve(100);
+
+	int sum{ 0 };
+	EXPECT_NO_ALLOCATIONS(for (int i = 0; i < 100; ++i) { sum = logged_Add(sum, i, 1); });
+	EXPECT_TRUE(sum == 5050);
+}
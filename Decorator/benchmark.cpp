@@ -0,0 +1,29 @@
+/*
+	Benchmarks for the Decorator demo: the overhead 'FuncLogger' adds to a call.
+
+	Updated: 2026-10-19
+	Author: Jonathan Helsing [github.com/Jonathan-source]
+*/
+
+#include "FuncLogger.h"
+#include "../Benchmarks/Benchmark.h"
+
+int Add(int a, int b, int c) {
+	return a + b + c;
+}
+
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSuite suite{ ParseBenchmarkOptions(argc, argv) };
+	suite.PrintHeader();
+
+	int sum{ 0 };
+	suite.Run("Add (undecorated)", [&] { sum = Add(sum, 1, 2); DoNotOptimize(sum); });
+
+	auto logged_Add{ CreateFuncLogger(Add) };
+	suite.Run("FuncLogger::operator()", [&] { sum = logged_Add(sum, 1, 2); });
+	DoNotOptimize(sum);
+
+	return suite.Finish();
+}
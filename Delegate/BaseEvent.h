@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../Instrumentation/Instrumentation.h"
+
+#include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
+
+template <typename... TArgs>
+class BaseEvent {
+public:
+    using EventCallback = std::function<void(TArgs...)>;
+
+    void operator+=(EventCallback func) {
+        m_subsribers.emplace_back(std::move(func));
+    }
+
+    void operator()(TArgs... args) {
+        Broadcast(args...);
+    }
+
+    void Broadcast(TArgs... args) {
+        INSTRUMENT_COUNT(EventBroadcasts, 1);
+        INSTRUMENT_COUNT(EventSubscribersVisited, m_subsribers.size());
+        for (const auto& subscriber : m_subsribers) {
+            assert(subscriber != nullptr);
+            subscriber(args...);
+        }
+    }
+
+private:
+    std::vector<EventCallback> m_subsribers;
+};
+
+#define DECLARE_EVENT(EventType, EventDispatcherType, ...)  \
+    class EventType : public BaseEvent<__VA_ARGS__>         \
+    {                                                       \
+        friend class EventDispatcherType;                   \
+    };                                                      \
+
@@ -0,0 +1,15 @@
+#include "BaseEvent.h"
+#include "../TestSupport/AllocationTracker.h"
+
+
+TEST(Delegate, BroadcastDoesNotAllocate) {
+    BaseEvent<int> event;
+    int sum = 0;
+    for (int i = 0; i < 8; ++i) {
+        event += [&sum](int value) { sum += value; };
+    }
+
+    EXPECT_NO_ALLOCATIONS(event.Broadcast(1));
+    EXPECT_NO_ALLOCATIONS(event(2));
+    EXPECT_TRUE(sum == 24);
+}
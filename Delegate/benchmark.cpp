@@ -0,0 +1,28 @@
+/*
+    Benchmarks for the Delegate demo: the cost of broadcasting an event to
+    its subscribers.
+
+    Updated: 2026-10-19
+    Author: Jonathan Helsing [github.com/Jonathan-source]
+*/
+
+#include "BaseEvent.h"
+#include "../Benchmarks/Benchmark.h"
+
+
+int main(int argc, char* argv[]) {
+    BenchmarkSuite suite{ ParseBenchmarkOptions(argc, argv) };
+    suite.PrintHeader();
+
+    int sum = 0;
+    for (const int subscribers : { 1, 4, 16 }) {
+        BaseEvent<int> event;
+        for (int i = 0; i < subscribers; ++i) {
+            event += [&sum](int value) { sum += value; };
+        }
+        suite.Run("BaseEvent::Broadcast/" + std::to_string(subscribers), [&] { event.Broadcast(1); });
+    }
+    DoNotOptimize(sum);
+
+    return suite.Finish();
+}
@@ -1,41 +1,6 @@
 #include <iostream>
-#include <functional>
-#include <vector>
-#include <cassert>
-
-//
-// BaseEvent.h
-//
-template <typename... TArgs>
-class BaseEvent {
-public:
-    using EventCallback = std::function<void(TArgs...)>;
-
-    void operator+=(EventCallback func) {
-        m_subsribers.emplace_back(func);
-    }
-
-    void operator()(TArgs... args) {
-        Broadcast(args...);
-    }
-
-    void Broadcast(TArgs... args) {
-        for (const auto& subscriber : m_subsribers) {
-            assert(subscriber != nullptr);
-            subscriber(args...);
-        }
-    }
-
-private:
-    std::vector<EventCallback> m_subsribers;
-};
-
-#define DECLARE_EVENT(EventType, EventDispatcherType, ...)  \
-    class EventType : public BaseEvent<__VA_ARGS__>         \
-    {                                                       \
-        friend class EventDispatcherType;                   \
-    };                                                      \
 
+#include "BaseEvent.h"
 
 //
 // Events.h
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "HotDrinkFactories.h"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Concrete Factories produce a family of products that belong to a single
+ * variant. The factory guarantees that resulting products are compatible. Note
+ * that signatures of the Concrete Factory's methods return an abstract product,
+ * while inside the method a concrete product is instantiated.
+ */
+class DrinkFactory {
+public:
+	DrinkFactory() {
+		m_factories["chocolate"] = std::make_unique<ChocolateFactory>();
+		m_factories["coffee"] = std::make_unique<CoffeeFactory>();
+		m_factories["tea"] = std::make_unique<TeaFactory>();
+		
+	}
+	virtual ~DrinkFactory() = default;
+
+	std::unique_ptr<IHotDrink> MakeDrink(const std::string& name) {
+		// 'find' rather than 'operator[]', which would insert unknown names.
+		const auto factory = m_factories.find(name);
+		if (factory == m_factories.end()) {
+			throw std::invalid_argument("Unknown drink: " + name);
+		}
+		auto drink = factory->second->CreateProduct();
+		drink->Prepare();
+		std::cout << " Here you are..." << std::endl;
+		return drink;
+	}
+
+private:
+	typedef std::unordered_map<std::string, std::unique_ptr<IHotDrinkFactory>> FactoryMap;
+	FactoryMap m_factories;
+};
@@ -0,0 +1,26 @@
+#include "DrinkFactory.h"
+#include "../TestSupport/AllocationTracker.h"
+#include "../TestSupport/SilenceStdout.h"
+
+
+TEST(Factory, MakeDrinkOnlyAllocatesTheDrink) {
+	DrinkFactory drinkFactory;
+	const std::string name{ "coffee" };
+
+	// 'MakeDrink' prints; keep that out of the test output.
+	SilenceStdout silence;
+
+	EXPECT_ALLOCATIONS(1, drinkFactory.MakeDrink(name));
+}
+
+TEST(Factory, UnknownDrinkThrows) {
+	DrinkFactory drinkFactory;
+	bool thrown = false;
+	try {
+		drinkFactory.MakeDrink("lemonade");
+	}
+	catch (const std::invalid_argument&) {
+		thrown = true;
+	}
+	EXPECT_TRUE(thrown);
+}
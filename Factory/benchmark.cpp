@@ -0,0 +1,27 @@
+/*
+	Benchmarks for the Factory demo: creating a drink by name through the
+	super-factory.
+
+	Updated: 2026-10-19
+	Author: Jonathan Helsing [github.com/Jonathan-source]
+*/
+
+#include "DrinkFactory.h"
+#include "../Benchmarks/Benchmark.h"
+
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSuite suite{ ParseBenchmarkOptions(argc, argv) };
+	suite.PrintHeader();
+
+	DrinkFactory drinkFactory;
+	const std::string name{ "coffee" };
+	{
+		// 'MakeDrink' prints the drink it prepared.
+		SilenceStdout silence;
+		suite.Run("DrinkFactory::MakeDrink", [&] { DoNotOptimize(drinkFactory.MakeDrink(name)); });
+	}
+
+	return suite.Finish();
+}
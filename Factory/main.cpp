@@ -8,35 +8,7 @@
 	Author: Jonathan Helsing [github.com/Jonathan-source]
 */
 
-#include "HotDrinkFactories.h"
-
-/**
- * Concrete Factories produce a family of products that belong to a single
- * variant. The factory guarantees that resulting products are compatible. Note
- * that signatures of the Concrete Factory's methods return an abstract product,
- * while inside the method a concrete product is instantiated.
- */
-class DrinkFactory {
-public:
-	DrinkFactory() {
-		m_factories["chocolate"] = std::make_unique<ChocolateFactory>();
-		m_factories["coffee"] = std::make_unique<CoffeeFactory>();
-		m_factories["tea"] = std::make_unique<TeaFactory>();
-		
-	}
-	virtual ~DrinkFactory() = default;
-
-	std::unique_ptr<IHotDrink> MakeDrink(const std::string& name) {
-		auto drink = m_factories[name]->CreateProduct();
-		drink->Prepare();
-		std::cout << " Here you are..." << std::endl;
-		return drink;
-	}
-
-private:
-	typedef std::unordered_map<std::string, std::unique_ptr<IHotDrinkFactory>> FactoryMap;
-	FactoryMap m_factories;
-};
+#include "DrinkFactory.h"
 
 
 int main()
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+/**
+ * Hot-path instrumentation.
+ * Counters and gauges are only compiled in when DESIGNPATTERNS_INSTRUMENTATION
+ * is defined to 1 (the CMake option of the same name). Otherwise the
+ * INSTRUMENT_* macros expand to nothing and snapshots are all zeros.
+ *
+ * Every thread updates its own cache-line aligned block of counters, taken
+ * from a fixed pool on its first recording and returned when it exits.
+ * Recording never allocates, locks or shares a cache line with another
+ * thread, and is a plain load and store rather than an atomic
+ * read-modify-write. Only while more threads run than the pool holds do the
+ * extra ones share an overflow block, which uses atomic read-modify-writes.
+ * A snapshot sums the counters over all blocks and takes the maximum of the
+ * gauges, which record high-water marks.
+ */
+#if !defined(DESIGNPATTERNS_INSTRUMENTATION)
+	#define DESIGNPATTERNS_INSTRUMENTATION 0
+#endif
+
+namespace Instrumentation {
+
+enum class ECounter {
+	EventBroadcasts,		// BaseEvent::Broadcast calls.
+	EventSubscribersVisited,	// Subscribers invoked by those broadcasts.
+	ObserverNotifications,		// ISubject::NotifyObservers calls.
+	ObserversVisited,		// Observers notified by those calls.
+	ObserverRegistrations,		// ISubject::RegisterObserver calls.
+	InvokerExecutes,		// Invoker::Execute calls.
+	InvokerCommandsExecuted,	// Commands applied by those calls.
+	InvokerUndos,			// Invoker::Undo calls.
+	Count
+};
+
+enum class EGauge {
+	ObserverListSize,		// Largest observer list after a registration.
+	InvokerHistorySize,		// Longest Invoker history seen by Execute/Undo.
+	Count
+};
+
+constexpr bool kEnabled = DESIGNPATTERNS_INSTRUMENTATION != 0;
+constexpr std::size_t kCounterCount = static_cast<std::size_t>(ECounter::Count);
+constexpr std::size_t kGaugeCount = static_cast<std::size_t>(EGauge::Count);
+
+inline const char* GetName(ECounter counter) {
+	switch (counter) {
+		case ECounter::EventBroadcasts:		return "EventBroadcasts";
+		case ECounter::EventSubscribersVisited:	return "EventSubscribersVisited";
+		case ECounter::ObserverNotifications:	return "ObserverNotifications";
+		case ECounter::ObserversVisited:	return "ObserversVisited";
+		case ECounter::ObserverRegistrations:	return "ObserverRegistrations";
+		case ECounter::InvokerExecutes:		return "InvokerExecutes";
+		case ECounter::InvokerCommandsExecuted:	return "InvokerCommandsExecuted";
+		case ECounter::InvokerUndos:		return "InvokerUndos";
+		default: return "?";
+	}
+}
+
+inline const char* GetName(EGauge gauge) {
+	switch (gauge) {
+		case EGauge::ObserverListSize:		return "ObserverListSize";
+		case EGauge::InvokerHistorySize:	return "InvokerHistorySize";
+		default: return "?";
+	}
+}
+
+/**
+ * Aggregated values at one point in time.
+ */
+struct Snapshot {
+	std::array<std::uint64_t, kCounterCount> counters{ };
+	std::array<std::uint64_t, kGaugeCount> gauges{ };
+	std::chrono::steady_clock::time_point time{ std::chrono::steady_clock::now() };
+
+	std::uint64_t operator[](ECounter counter) const { return counters[static_cast<std::size_t>(counter)]; }
+	std::uint64_t operator[](EGauge gauge) const { return gauges[static_cast<std::size_t>(gauge)]; }
+
+	friend std::ostream& operator<<(std::ostream& os, const Snapshot& snapshot) {
+		for (std::size_t i = 0; i < kCounterCount; ++i) {
+			os << GetName(static_cast<ECounter>(i)) << ": " << snapshot.counters[i] << "\n";
+		}
+		for (std::size_t i = 0; i < kGaugeCount; ++i) {
+			os << GetName(static_cast<EGauge>(i)) << " (max): " << snapshot.gauges[i] << "\n";
+		}
+		return os;
+	}
+};
+
+#if DESIGNPATTERNS_INSTRUMENTATION
+
+namespace Detail {
+
+struct alignas(64) ThreadBlock {
+	std::array<std::atomic<std::uint64_t>, kCounterCount> counters{ };
+	std::array<std::atomic<std::uint64_t>, kGaugeCount> gauges{ };
+};
+
+// A thread owns a block while it runs. When it exits, its counts are added
+// to 'g_retired' and the block goes back on the free list, so the counts of
+// finished threads are kept and their blocks reused.
+constexpr std::size_t kMaxThreads = 256;
+inline ThreadBlock g_blocks[kMaxThreads];
+inline ThreadBlock g_retired;
+inline ThreadBlock g_overflow;
+
+// Guards the free list, 'g_retired' and the hand-over of blocks. Only taken
+// when a thread starts or stops recording, and by snapshots.
+inline std::mutex g_poolMutex;
+inline std::size_t g_freeBlocks[kMaxThreads];
+inline std::size_t g_freeCount = 0;
+inline std::size_t g_blockCount = 0;	// Blocks handed out at least once.
+inline thread_local ThreadBlock* t_block = nullptr;
+
+inline ThreadBlock* ClaimBlock() {
+	std::lock_guard<std::mutex> lock(g_poolMutex);
+	if (g_freeCount > 0) {
+		return &g_blocks[g_freeBlocks[--g_freeCount]];
+	}
+	return g_blockCount < kMaxThreads ? &g_blocks[g_blockCount++] : &g_overflow;
+}
+
+inline void RetireBlock(ThreadBlock& block) {
+	std::lock_guard<std::mutex> lock(g_poolMutex);
+	for (std::size_t i = 0; i < kCounterCount; ++i) {
+		const std::uint64_t total = g_retired.counters[i].load(std::memory_order_relaxed) + block.counters[i].load(std::memory_order_relaxed);
+		g_retired.counters[i].store(total, std::memory_order_relaxed);
+		block.counters[i].store(0, std::memory_order_relaxed);
+	}
+	for (std::size_t i = 0; i < kGaugeCount; ++i) {
+		const std::uint64_t max = std::max(g_retired.gauges[i].load(std::memory_order_relaxed), block.gauges[i].load(std::memory_order_relaxed));
+		g_retired.gauges[i].store(max, std::memory_order_relaxed);
+		block.gauges[i].store(0, std::memory_order_relaxed);
+	}
+	g_freeBlocks[g_freeCount++] = static_cast<std::size_t>(&block - g_blocks);
+}
+
+// Returns the thread's block to the pool when the thread exits.
+struct BlockLease {
+	ThreadBlock* block;
+
+	~BlockLease() {
+		// Whatever is recorded later during thread exit goes to the shared block.
+		t_block = &g_overflow;
+		if (block != &g_overflow) {
+			RetireBlock(*block);
+		}
+	}
+};
+
+inline ThreadBlock& GetThreadBlock() {
+	if (!t_block) {
+		thread_local BlockLease lease{ ClaimBlock() };
+		t_block = lease.block;
+	}
+	return *t_block;
+}
+
+} // namespace Detail
+
+inline void Add(ECounter counter, std::uint64_t amount) {
+	Detail::ThreadBlock& block = Detail::GetThreadBlock();
+	std::atomic<std::uint64_t>& slot = block.counters[static_cast<std::size_t>(counter)];
+	if (&block != &Detail::g_overflow) {
+		// The only writer: snapshots just need the store to be atomic.
+		slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+	else {
+		slot.fetch_add(amount, std::memory_order_relaxed);
+	}
+}
+
+inline void RecordMax(EGauge gauge, std::uint64_t value) {
+	Detail::ThreadBlock& block = Detail::GetThreadBlock();
+	std::atomic<std::uint64_t>& slot = block.gauges[static_cast<std::size_t>(gauge)];
+	std::uint64_t current = slot.load(std::memory_order_relaxed);
+	if (&block != &Detail::g_overflow) {
+		if (value > current) {
+			slot.store(value, std::memory_order_relaxed);
+		}
+		return;
+	}
+	while (value > current && !slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+	}
+}
+
+inline Snapshot TakeSnapshot() {
+	Snapshot snapshot;
+	auto add = [&snapshot](const Detail::ThreadBlock& block) {
+		for (std::size_t i = 0; i < kCounterCount; ++i) {
+			snapshot.counters[i] += block.counters[i].load(std::memory_order_relaxed);
+		}
+		for (std::size_t i = 0; i < kGaugeCount; ++i) {
+			snapshot.gauges[i] = std::max(snapshot.gauges[i], block.gauges[i].load(std::memory_order_relaxed));
+		}
+	};
+
+	// Under the pool lock, so a retiring thread is counted exactly once.
+	std::lock_guard<std::mutex> lock(Detail::g_poolMutex);
+	for (std::size_t b = 0; b < Detail::g_blockCount; ++b) {
+		add(Detail::g_blocks[b]);
+	}
+	add(Detail::g_retired);
+	add(Detail::g_overflow);
+	return snapshot;
+}
+
+#define INSTRUMENT_COUNT(counter, amount) \
+	::Instrumentation::Add(::Instrumentation::ECounter::counter, static_cast<std::uint64_t>(amount))
+#define INSTRUMENT_MAX(gauge, value) \
+	::Instrumentation::RecordMax(::Instrumentation::EGauge::gauge, static_cast<std::uint64_t>(value))
+
+#else
+
+inline Snapshot TakeSnapshot() {
+	return Snapshot{ };
+}
+
+#define INSTRUMENT_COUNT(counter, amount) ((void)0)
+#define INSTRUMENT_MAX(gauge, value) ((void)0)
+
+#endif
+
+/**
+ * Periodic sampling: each call to 'Next' returns what the counters did
+ * since the previous call, e.g. once per frame or once per second.
+ */
+class Sampler {
+public:
+	struct Sample {
+		Snapshot total;
+		std::array<std::uint64_t, kCounterCount> delta{ };
+		std::chrono::nanoseconds elapsed{ 0 };
+
+		std::uint64_t operator[](ECounter counter) const { return delta[static_cast<std::size_t>(counter)]; }
+
+		// Events per second over the sampled period.
+		double GetRate(ECounter counter) const {
+			const double seconds = std::chrono::duration<double>(elapsed).count();
+			return seconds > 0.0 ? static_cast<double>((*this)[counter]) / seconds : 0.0;
+		}
+	};
+
+	Sampler() : m_previous(TakeSnapshot()) {}
+
+	Sample Next() {
+		Sample sample;
+		sample.total = TakeSnapshot();
+		for (std::size_t i = 0; i < kCounterCount; ++i) {
+			sample.delta[i] = sample.total.counters[i] - m_previous.counters[i];
+		}
+		sample.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(sample.total.time - m_previous.time);
+		m_previous = sample.total;
+		return sample;
+	}
+
+private:
+	Snapshot m_previous;
+};
+
+} // namespace Instrumentation
@@ -0,0 +1,140 @@
+// Always built with the instrumentation compiled in, whatever the build option.
+#include "Instrumentation.h"
+#include "../Delegate/BaseEvent.h"
+#include "../Observer/ISubject.h"
+#include "../Observer/Events.h"
+#include "../Command/Invoker.h"
+#include "../TestSupport/AllocationTracker.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using Instrumentation::ECounter;
+using Instrumentation::EGauge;
+
+static_assert(Instrumentation::kEnabled, "The instrumentation tests need DESIGNPATTERNS_INSTRUMENTATION=1");
+
+
+class Subject : public ISubject<Subject> {
+};
+
+class NopObserver : public IObserver<Subject> {
+public:
+	NotifyAction OnNotify(Subject&, const Event&) override { return NotifyAction::Done; }
+};
+
+
+TEST(Instrumentation, CountsBroadcastsAndSubscribers) {
+	Instrumentation::Sampler sampler;
+
+	BaseEvent<int> event;
+	event += [](int) {};
+	event += [](int) {};
+	event.Broadcast(1);
+	event(2);
+
+	const auto sample = sampler.Next();
+	EXPECT_TRUE(sample[ECounter::EventBroadcasts] == 2);
+	EXPECT_TRUE(sample[ECounter::EventSubscribersVisited] == 4);
+}
+
+TEST(Instrumentation, CountsNotificationsAndObserverListSize) {
+	Instrumentation::Sampler sampler;
+
+	Subject subject;
+	std::vector<NopObserver> observers(3);
+	for (auto& observer : observers) {
+		subject.RegisterObserver(observer);
+	}
+	subject.NotifyObservers(subject, Event::CRITTER_KILLED);
+
+	const auto sample = sampler.Next();
+	EXPECT_TRUE(sample[ECounter::ObserverRegistrations] == 3);
+	EXPECT_TRUE(sample[ECounter::ObserverNotifications] == 1);
+	EXPECT_TRUE(sample[ECounter::ObserversVisited] == 3);
+	EXPECT_TRUE(sample.total[EGauge::ObserverListSize] >= 3);
+}
+
+TEST(Instrumentation, CountsInvokerActivityAcrossThreads) {
+	Instrumentation::Sampler sampler;
+
+	auto run = [] {
+		Player player{ 0, 0 };
+		Invoker invoker{ InvokerConfig{ 256, false } };
+		for (int i = 0; i < 10; ++i) {
+			invoker.AddCommand(MovePlayerCommand{ player, MovePlayerCommand::EAction::Up });
+		}
+		invoker.Execute();
+		invoker.Undo();
+	};
+	std::thread first(run);
+	std::thread second(run);
+	first.join();
+	second.join();
+
+	const auto sample = sampler.Next();
+	EXPECT_TRUE(sample[ECounter::InvokerExecutes] == 2);
+	EXPECT_TRUE(sample[ECounter::InvokerCommandsExecuted] == 20);
+	EXPECT_TRUE(sample[ECounter::InvokerUndos] == 2);
+	EXPECT_TRUE(sample.total[EGauge::InvokerHistorySize] >= 10);
+}
+
+TEST(Instrumentation, RecordingDoesNotAllocate) {
+	BaseEvent<int> event;
+	event += [](int) {};
+
+	// Also the first use on a new thread, which claims a counter block.
+	std::thread thread([&] { EXPECT_NO_ALLOCATIONS(event.Broadcast(1)); });
+	thread.join();
+}
+
+TEST(Instrumentation, ReusesTheBlocksOfFinishedThreads) {
+	Instrumentation::Sampler sampler;
+	const std::uint64_t shared = Instrumentation::Detail::g_overflow.counters[static_cast<std::size_t>(ECounter::EventBroadcasts)].load();
+
+	// Many more threads than blocks, one after the other: none needs the overflow block.
+	constexpr std::size_t kThreads = 2 * Instrumentation::Detail::kMaxThreads;
+	for (std::size_t i = 0; i < kThreads; ++i) {
+		std::thread([] { INSTRUMENT_COUNT(EventBroadcasts, 1); }).join();
+	}
+
+	const auto sample = sampler.Next();
+	EXPECT_TRUE(sample[ECounter::EventBroadcasts] == kThreads);
+	EXPECT_TRUE(Instrumentation::Detail::g_overflow.counters[static_cast<std::size_t>(ECounter::EventBroadcasts)].load() == shared);
+}
+
+TEST(Instrumentation, CountsThreadsBeyondThePool) {
+	Instrumentation::Sampler sampler;
+
+	// More threads than blocks alive at once, so some share the overflow block.
+	constexpr std::size_t kThreads = Instrumentation::Detail::kMaxThreads + 4;
+	std::atomic<std::size_t> started{ 0 };
+	std::atomic<bool> release{ false };
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < kThreads; ++i) {
+		threads.emplace_back([&] {
+			INSTRUMENT_COUNT(EventBroadcasts, 1);
+			++started;
+			while (!release) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			for (int j = 0; j < 1000; ++j) {
+				INSTRUMENT_COUNT(EventBroadcasts, 1);
+				INSTRUMENT_MAX(InvokerHistorySize, j);
+			}
+		});
+	}
+	while (started < kThreads) {
+		std::this_thread::yield();
+	}
+	release = true;
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	const auto sample = sampler.Next();
+	EXPECT_TRUE(sample[ECounter::EventBroadcasts] == kThreads * 1001);
+	EXPECT_TRUE(sample.total[EGauge::InvokerHistorySize] >= 999);
+}
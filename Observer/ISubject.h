@@ -1,7 +1,9 @@
 #pragma once
 
 #include "IObserver.h"
+#include "../Instrumentation/Instrumentation.h"
 
+#include <algorithm>
 #include <vector>
 #include <stdexcept>
 
@@ -21,6 +23,9 @@ public:
 		//}
 
 		m_observers.emplace_back(&observer);
+
+		INSTRUMENT_COUNT(ObserverRegistrations, 1);
+		INSTRUMENT_MAX(ObserverListSize, m_observers.size());
 	}
 
 	void UnregisterObserver(IObserver<T>& observer)
@@ -30,25 +35,22 @@ public:
 
 	void NotifyObservers(T& subject, const Event& event)
 	{
-    	std::vector<IObserver<T>*> deadObservers;
-    	for (auto& observer : m_observers)
-    	{
-        	if (observer->OnNotify(subject, event) == NotifyAction::Unregister)
-        	{
-            	deadObservers.emplace_back(observer);
-        	}
-    }
-
-    // Remove the dead observers.
-    auto newEnd = m_observers.end();
-    for (auto& dead : deadObservers)
-    {
-        newEnd = std::remove(m_observers.begin(), newEnd, dead);
-    }
-
-    m_observers.erase(newEnd, m_observers.end());
-
-  }
+		INSTRUMENT_COUNT(ObserverNotifications, 1);
+		INSTRUMENT_COUNT(ObserversVisited, m_observers.size());
+
+		// Observers asking to be unregistered are dropped by compacting the
+		// list in place while iterating, so notifying never allocates.
+		auto kept = m_observers.begin();
+		for (auto observer = m_observers.begin(); observer != m_observers.end(); ++observer)
+		{
+			if ((*observer)->OnNotify(subject, event) != NotifyAction::Unregister)
+			{
+				*kept++ = *observer;
+			}
+		}
+
+		m_observers.erase(kept, m_observers.end());
+	}
 
 private:
 
@@ -0,0 +1,57 @@
+#include "IObserver.h"
+#include "ISubject.h"
+#include "Events.h"
+#include "../TestSupport/AllocationTracker.h"
+
+#include <vector>
+
+
+class Subject : public ISubject<Subject> {
+};
+
+class CountingObserver : public IObserver<Subject> {
+
+public:
+
+    NotifyAction OnNotify(Subject&, const Event&) override
+    {
+        ++m_count;
+        return m_count >= m_lifetime ? NotifyAction::Unregister : NotifyAction::Done;
+    }
+
+    int m_count = 0;
+    int m_lifetime = 1000;
+
+};
+
+
+TEST(Observer, NotifyObserversDoesNotAllocate)
+{
+    Subject subject;
+    std::vector<CountingObserver> observers(8);
+    for (auto& observer : observers)
+    {
+        subject.RegisterObserver(observer);
+    }
+
+    EXPECT_NO_ALLOCATIONS(subject.NotifyObservers(subject, Event::CRITTER_KILLED));
+    EXPECT_TRUE(observers[7].m_count == 1);
+}
+
+TEST(Observer, UnregisteringDuringNotifyDoesNotAllocate)
+{
+    Subject subject;
+    std::vector<CountingObserver> observers(8);
+    for (std::size_t i = 0; i < observers.size(); ++i)
+    {
+        observers[i].m_lifetime = i % 2 ? 1 : 2;
+        subject.RegisterObserver(observers[i]);
+    }
+
+    EXPECT_NO_ALLOCATIONS(subject.NotifyObservers(subject, Event::CRITTER_KILLED));
+    EXPECT_NO_ALLOCATIONS(subject.NotifyObservers(subject, Event::CRITTER_KILLED));
+
+    // Odd observers left after the first notification, even ones after the second.
+    EXPECT_TRUE(observers[1].m_count == 1);
+    EXPECT_TRUE(observers[0].m_count == 2);
+}
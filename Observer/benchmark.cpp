@@ -0,0 +1,57 @@
+/*
+    Benchmarks for the Observer demo: notifying every registered observer.
+
+    Updated: 2026-10-19
+    Author: Jonathan Helsing [github.com/Jonathan-source]
+*/
+
+#include "IObserver.h"
+#include "ISubject.h"
+#include "Events.h"
+#include "../Benchmarks/Benchmark.h"
+
+#include <string>
+#include <vector>
+
+
+class Subject : public ISubject<Subject> {
+};
+
+class CountingObserver : public IObserver<Subject> {
+
+public:
+
+    NotifyAction OnNotify(Subject&, const Event& event) override
+    {
+        if (event == Event::CRITTER_KILLED)
+        {
+            ++m_count;
+        }
+        return NotifyAction::Done;
+    }
+
+    int m_count = 0;
+
+};
+
+
+int main(int argc, char* argv[])
+{
+    BenchmarkSuite suite{ ParseBenchmarkOptions(argc, argv) };
+    suite.PrintHeader();
+
+    for (const std::size_t count : { 1, 8, 64 })
+    {
+        Subject subject;
+        std::vector<CountingObserver> observers(count);
+        for (auto& observer : observers)
+        {
+            subject.RegisterObserver(observer);
+        }
+        suite.Run("ISubject::NotifyObservers/" + std::to_string(count), [&] {
+            subject.NotifyObservers(subject, Event::CRITTER_KILLED);
+        });
+    }
+
+    return suite.Finish();
+}
@@ -82,7 +82,7 @@ public:
     AudioManager() = default;
     virtual ~AudioManager() = default;
 
-    NotifyAction OnNotify(Player& subject, const Event& event) override
+    NotifyAction OnNotify(Player&, const Event& event) override
     {
         if (event == Event::CRITTER_KILLED)
         {       
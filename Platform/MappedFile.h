@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+	// Keep <windows.h> from defining 'min'/'max' macros for everything included after it.
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/**
+ * Read-only memory mapping of a whole file.
+ * An empty file maps to an empty range. The file may still be open for
+ * writing elsewhere, e.g. a journal that is being appended to.
+ */
+class MappedFile
+{
+public:
+	explicit MappedFile(const std::string& path)
+	{
+#if defined(_WIN32)
+		m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		LARGE_INTEGER size{};
+		if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size))
+		{
+			Close();
+			throw std::runtime_error("Unable to open '" + path + "'");
+		}
+		m_size = static_cast<std::size_t>(size.QuadPart);
+		if (m_size > 0)
+		{
+			m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			m_data = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		}
+#else
+		m_file = open(path.c_str(), O_RDONLY);
+		struct stat info{};
+		if (m_file < 0 || fstat(m_file, &info) != 0)
+		{
+			Close();
+			throw std::runtime_error("Unable to open '" + path + "'");
+		}
+		m_size = static_cast<std::size_t>(info.st_size);
+		if (m_size > 0)
+		{
+			m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+			if (m_data == MAP_FAILED)
+			{
+				m_data = nullptr;
+			}
+			else
+			{
+				madvise(m_data, m_size, MADV_SEQUENTIAL);
+			}
+		}
+#endif
+		if (m_size > 0 && !m_data)
+		{
+			Close();
+			throw std::runtime_error("Unable to map '" + path + "'");
+		}
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile()
+	{
+		Close();
+	}
+
+	const std::uint8_t* GetData() const { return static_cast<const std::uint8_t*>(m_data); }
+	std::size_t GetSize() const { return m_size; }
+
+private:
+	void Close()
+	{
+#if defined(_WIN32)
+		if (m_data) UnmapViewOfFile(m_data);
+		if (m_mapping) CloseHandle(m_mapping);
+		if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+		m_mapping = nullptr;
+		m_file = INVALID_HANDLE_VALUE;
+#else
+		if (m_data) munmap(m_data, m_size);
+		if (m_file >= 0) close(m_file);
+		m_file = -1;
+#endif
+		m_data = nullptr;
+	}
+
+#if defined(_WIN32)
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+#else
+	int m_file = -1;
+#endif
+	void* m_data = nullptr;
+	std::size_t m_size = 0;
+};
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <typeinfo>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+class ServiceRegistry;
+
+/**
+ * Base for singletons that are created by a 'ServiceRegistry'.
+ * Unlike 'Singleton<T>' there is no lazy construction: 'Get' is a plain
+ * pointer dereference, valid between 'ServiceRegistry::Startup' and
+ * 'ServiceRegistry::Shutdown'.
+ */
+template <typename T>
+struct Service
+{
+	static inline T& Get() noexcept
+	{
+		return *s_instance;
+	}
+
+	static inline bool IsRunning() noexcept
+	{
+		return s_instance != nullptr;
+	}
+
+protected:
+	Service() = default;
+	Service(const Service&) = delete;
+	Service(Service&&) noexcept = delete;
+
+	Service& operator=(const Service&) = delete;
+	Service& operator=(Service&&) noexcept = delete;
+
+private:
+	friend class ServiceRegistry;
+	static inline T* s_instance = nullptr;
+};
+
+/**
+ * Creates services eagerly, each one after the services it depends on.
+ * Services whose dependencies are all running are constructed in parallel
+ * on a small pool of worker threads. Shutdown destroys them in the reverse
+ * of the initialization order.
+ */
+class ServiceRegistry
+{
+public:
+	ServiceRegistry() = default;
+	ServiceRegistry(const ServiceRegistry&) = delete;
+	ServiceRegistry& operator=(const ServiceRegistry&) = delete;
+
+	~ServiceRegistry()
+	{
+		Shutdown();
+	}
+
+	// Declares the service 'T', which must be created after 'TDependencies'.
+	template <typename T, typename... TDependencies>
+	void Register()
+	{
+		static_assert(std::is_base_of<Service<T>, T>::value, "T must derive from Service<T>");
+
+		const std::type_index type{ typeid(T) };
+		if (m_lookup.count(type) != 0)
+		{
+			throw std::logic_error(std::string("Service registered twice: ") + typeid(T).name());
+		}
+
+		Node node;
+		node.name = typeid(T).name();
+		node.dependencies = { std::type_index(typeid(TDependencies))... };
+		node.create = []
+		{
+			// Another registry already owns the instance.
+			if (Service<T>::IsRunning())
+			{
+				throw std::logic_error(std::string("Service is already running: ") + typeid(T).name());
+			}
+			Service<T>::s_instance = new T();
+		};
+		node.destroy = [] { delete Service<T>::s_instance; Service<T>::s_instance = nullptr; };
+
+		m_lookup.emplace(type, m_nodes.size());
+		m_nodes.emplace_back(std::move(node));
+	}
+
+	/**
+	 * Creates every registered service. Throws if a dependency is missing or
+	 * cyclic, or if a service is already running (e.g. started by another
+	 * registry), or rethrows the first exception thrown by a constructor,
+	 * after destroying the services that were already created.
+	 */
+	void Startup(std::size_t threadCount = std::thread::hardware_concurrency())
+	{
+		if (!m_order.empty())
+		{
+			throw std::logic_error("Services are already running");
+		}
+		m_order = SortByDependencies();
+
+		std::vector<std::size_t> remaining(m_nodes.size());
+		std::deque<std::size_t> ready;
+		for (std::size_t i = 0; i < m_nodes.size(); ++i)
+		{
+			remaining[i] = m_nodes[i].dependencies.size();
+			if (remaining[i] == 0)
+			{
+				ready.push_back(i);
+			}
+		}
+
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::size_t finished = 0;
+		std::vector<bool> created(m_nodes.size(), false);
+		std::exception_ptr error;
+
+		auto worker = [&]
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			for (;;)
+			{
+				wake.wait(lock, [&] { return !ready.empty() || finished == m_nodes.size() || error; });
+				if (ready.empty())
+				{
+					return;
+				}
+
+				const std::size_t index = ready.front();
+				ready.pop_front();
+
+				lock.unlock();
+				std::exception_ptr failure;
+				try
+				{
+					m_nodes[index].create();
+				}
+				catch (...)
+				{
+					failure = std::current_exception();
+				}
+				lock.lock();
+
+				if (failure)
+				{
+					// Nothing else is started; running constructors are allowed to finish.
+					error = error ? error : failure;
+					ready.clear();
+				}
+				else
+				{
+					created[index] = true;
+					++finished;
+					if (!error)
+					{
+						for (const std::size_t dependent : m_nodes[index].dependents)
+						{
+							if (--remaining[dependent] == 0)
+							{
+								ready.push_back(dependent);
+							}
+						}
+					}
+				}
+				wake.notify_all();
+			}
+		};
+
+		std::vector<std::thread> workers;
+		const std::size_t workerCount = std::max<std::size_t>(1, std::min(threadCount, m_nodes.size()));
+		for (std::size_t i = 0; i < workerCount; ++i)
+		{
+			workers.emplace_back(worker);
+		}
+		for (auto& thread : workers)
+		{
+			thread.join();
+		}
+
+		if (error)
+		{
+			for (auto it = m_order.rbegin(); it != m_order.rend(); ++it)
+			{
+				if (created[*it])
+				{
+					m_nodes[*it].destroy();
+				}
+			}
+			m_order.clear();
+			std::rethrow_exception(error);
+		}
+	}
+
+	// Destroys the services, dependents before their dependencies.
+	void Shutdown()
+	{
+		for (auto it = m_order.rbegin(); it != m_order.rend(); ++it)
+		{
+			m_nodes[*it].destroy();
+		}
+		m_order.clear();
+	}
+
+private:
+	struct Node
+	{
+		const char* name;
+		std::vector<std::type_index> dependencies;
+		std::vector<std::size_t> dependents;
+		std::function<void()> create;
+		std::function<void()> destroy;
+	};
+
+	// Resolves the dependency edges and returns a topological order (Kahn).
+	std::vector<std::size_t> SortByDependencies()
+	{
+		std::vector<std::size_t> incoming(m_nodes.size(), 0);
+		for (auto& node : m_nodes)
+		{
+			node.dependents.clear();
+		}
+		for (std::size_t i = 0; i < m_nodes.size(); ++i)
+		{
+			for (const auto& dependency : m_nodes[i].dependencies)
+			{
+				const auto found = m_lookup.find(dependency);
+				if (found == m_lookup.end())
+				{
+					throw std::logic_error(std::string("Service ") + m_nodes[i].name + " depends on unregistered " + dependency.name());
+				}
+				m_nodes[found->second].dependents.push_back(i);
+				++incoming[i];
+			}
+		}
+
+		std::vector<std::size_t> order;
+		order.reserve(m_nodes.size());
+		for (std::size_t i = 0; i < m_nodes.size(); ++i)
+		{
+			if (incoming[i] == 0)
+			{
+				order.push_back(i);
+			}
+		}
+		for (std::size_t next = 0; next < order.size(); ++next)
+		{
+			for (const std::size_t dependent : m_nodes[order[next]].dependents)
+			{
+				if (--incoming[dependent] == 0)
+				{
+					order.push_back(dependent);
+				}
+			}
+		}
+
+		if (order.size() != m_nodes.size())
+		{
+			throw std::logic_error("Cyclic dependency between services");
+		}
+		return order;
+	}
+
+	std::vector<Node> m_nodes;
+	std::unordered_map<std::type_index, std::size_t> m_lookup;
+	std::vector<std::size_t> m_order;
+};
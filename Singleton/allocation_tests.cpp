@@ -0,0 +1,25 @@
+#include "Singleton.h"
+#include "ServiceRegistry.h"
+#include "../TestSupport/AllocationTracker.h"
+
+
+class LazyCounter : public Singleton<LazyCounter> {
+public:
+    int value = 0;
+};
+
+class EagerCounter : public Service<EagerCounter> {
+public:
+    int value = 0;
+};
+
+
+TEST(Singleton, GetDoesNotAllocate) {
+    EXPECT_NO_ALLOCATIONS(++LazyCounter::Get().value);
+
+    ServiceRegistry services;
+    services.Register<EagerCounter>();
+    services.Startup(1);
+    EXPECT_NO_ALLOCATIONS(++EagerCounter::Get().value);
+    services.Shutdown();
+}
@@ -0,0 +1,39 @@
+/*
+    Benchmarks for the Singleton demo: access through the lazily constructed
+    'Singleton<T>' against the eagerly created 'Service<T>'.
+
+    Updated: 2026-10-19
+    Author: Jonathan Helsing [github.com/Jonathan-source]
+*/
+
+#include "Singleton.h"
+#include "ServiceRegistry.h"
+#include "../Benchmarks/Benchmark.h"
+
+
+class LazyCounter : public Singleton<LazyCounter> {
+public:
+    int value = 0;
+};
+
+class EagerCounter : public Service<EagerCounter> {
+public:
+    int value = 0;
+};
+
+
+int main(int argc, char* argv[])
+{
+    BenchmarkSuite suite{ ParseBenchmarkOptions(argc, argv) };
+    suite.PrintHeader();
+
+    suite.Run("Singleton::Get", [] { DoNotOptimize(++LazyCounter::Get().value); });
+
+    ServiceRegistry services;
+    services.Register<EagerCounter>();
+    services.Startup(1);
+    suite.Run("Service::Get", [] { DoNotOptimize(++EagerCounter::Get().value); });
+    services.Shutdown();
+
+    return suite.Finish();
+}
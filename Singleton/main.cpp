@@ -3,34 +3,23 @@
     This is useful when exactly one object is needed to coordinate actions across the system, for example a Logger or Database class.
     
     In this particular example I experimented with creating a Singleton template class tailored to use for classes that should be Singleton.
+    The 'ServiceRegistry' takes it a step further: services declare what they depend on and are all created eagerly at startup, in
+    dependency order and in parallel where possible, and destroyed in reverse order at shutdown. Afterwards 'Service<T>::Get()' is a
+    plain pointer access.
 
     Note: this implementation is not reliable in a multithreaded environment, however it works generally fine in a single-threaded
     environment, though interrupts can be problematic. Also, Singletons are difficult to mock for testing when necessary and not 
     scaleable. The dependency injection design pattern is preferable in the vast majority of cases.
 
-    Updated: 2023-11-27
+    Updated: 2026-10-19
     Author: Jonathan Helsing [github.com/Jonathan-source]
 */
 
 #include <iostream>
+#include <string>
 
-template <typename T>
-struct Singleton
-{
-	static inline T& Get() noexcept
-	{
-		static T instance;
-		return instance;
-	}
-
-protected:
-	Singleton() = default;
-	Singleton(const Singleton&) = delete;
-	Singleton(Singleton&&) noexcept = delete;
-
-	Singleton& operator=(const Singleton&) = delete;
-	Singleton& operator=(Singleton&&) noexcept = delete;
-};
+#include "Singleton.h"
+#include "ServiceRegistry.h"
 
 
 class Application : public Singleton<Application> {
@@ -38,10 +27,49 @@ public:
     // ...
 };
 
+
+class Logger : public Service<Logger> {
+public:
+    Logger() { Log("Logger started"); }
+    ~Logger() { Log("Logger stopped"); }
+
+    void Log(const std::string& message) { std::cout << message + "\n"; }
+};
+
+class Database : public Service<Database> {
+public:
+    Database() { Logger::Get().Log("Database connected"); }
+    ~Database() { Logger::Get().Log("Database disconnected"); }
+};
+
+class AudioEngine : public Service<AudioEngine> {
+public:
+    AudioEngine() { Logger::Get().Log("AudioEngine started"); }
+    ~AudioEngine() { Logger::Get().Log("AudioEngine stopped"); }
+};
+
+class GameWorld : public Service<GameWorld> {
+public:
+    GameWorld() { Logger::Get().Log("GameWorld loaded"); }
+    ~GameWorld() { Logger::Get().Log("GameWorld unloaded"); }
+};
+
+
 int main()
 {
-    // Eager initialization.
+    // Lazy initialization.
     Application::Get();
 
+    // Eager initialization, in dependency order.
+    ServiceRegistry services;
+    services.Register<Logger>();
+    services.Register<Database, Logger>();
+    services.Register<AudioEngine, Logger>();
+    services.Register<GameWorld, Database, AudioEngine>();
+
+    services.Startup();
+    Logger::Get().Log("Running...");
+    services.Shutdown();
+
     return 0;
 }
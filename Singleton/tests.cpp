@@ -0,0 +1,126 @@
+#include "ServiceRegistry.h"
+#include "../TestSupport/AllocationTracker.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+// Construction ('+') and destruction ('-') events of the services, in order.
+std::mutex g_mutex;
+std::vector<std::string> g_events;
+
+void Record(const std::string& event) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_events.push_back(event);
+}
+
+std::size_t IndexOf(const std::string& event) {
+    return static_cast<std::size_t>(std::find(g_events.begin(), g_events.end(), event) - g_events.begin());
+}
+
+template <char Name>
+class Logged : public Service<Logged<Name>> {
+public:
+    Logged() { Record(std::string("+") + Name); }
+    ~Logged() { Record(std::string("-") + Name); }
+};
+
+using A = Logged<'A'>;
+using B = Logged<'B'>;
+using C = Logged<'C'>;
+using D = Logged<'D'>;
+
+class Failing : public Service<Failing> {
+public:
+    Failing() { throw std::runtime_error("Failing service"); }
+};
+
+class Unregistered : public Service<Unregistered> {
+};
+
+template <typename TException, typename TFunc>
+bool Throws(TFunc func) {
+    try {
+        func();
+    }
+    catch (const TException&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+
+TEST(ServiceRegistry, StartsDependenciesFirstAndStopsInReverse) {
+    g_events.clear();
+    {
+        ServiceRegistry services;
+        services.Register<C, B>();
+        services.Register<B, A>();
+        services.Register<D, A>();
+        services.Register<A>();
+        services.Startup(4);
+        EXPECT_TRUE(A::IsRunning() && B::IsRunning() && C::IsRunning() && D::IsRunning());
+        EXPECT_TRUE(IndexOf("+A") < IndexOf("+B") && IndexOf("+B") < IndexOf("+C") && IndexOf("+A") < IndexOf("+D"));
+    }
+    EXPECT_TRUE(g_events.size() == 8);
+    EXPECT_TRUE(!A::IsRunning() && !B::IsRunning() && !C::IsRunning() && !D::IsRunning());
+    EXPECT_TRUE(IndexOf("-C") < IndexOf("-B") && IndexOf("-B") < IndexOf("-A") && IndexOf("-D") < IndexOf("-A"));
+}
+
+TEST(ServiceRegistry, MissingDependencyThrows) {
+    ServiceRegistry services;
+    services.Register<A, Unregistered>();
+    EXPECT_TRUE(Throws<std::logic_error>([&] { services.Startup(2); }));
+    EXPECT_TRUE(!A::IsRunning());
+}
+
+TEST(ServiceRegistry, CyclicDependencyThrows) {
+    ServiceRegistry services;
+    services.Register<A, C>();
+    services.Register<B, A>();
+    services.Register<C, B>();
+    services.Register<D>();
+    EXPECT_TRUE(Throws<std::logic_error>([&] { services.Startup(2); }));
+    EXPECT_TRUE(!A::IsRunning() && !D::IsRunning());
+}
+
+TEST(ServiceRegistry, ThrowingConstructorRollsBack) {
+    g_events.clear();
+    ServiceRegistry services;
+    services.Register<A>();
+    services.Register<B, A>();
+    services.Register<Failing, B>();
+    services.Register<C, Failing>();
+    EXPECT_TRUE(Throws<std::runtime_error>([&] { services.Startup(2); }));
+
+    // A and B were destroyed again, dependents first; C was never started.
+    EXPECT_TRUE(!A::IsRunning() && !B::IsRunning() && !C::IsRunning() && !Failing::IsRunning());
+    EXPECT_TRUE((g_events == std::vector<std::string>{ "+A", "+B", "-B", "-A" }));
+
+    // Nothing is left behind that keeps A from being started again.
+    ServiceRegistry retry;
+    retry.Register<A>();
+    retry.Startup(1);
+    EXPECT_TRUE(A::IsRunning());
+}
+
+TEST(ServiceRegistry, SecondRegistryCannotStartARunningService) {
+    ServiceRegistry first;
+    first.Register<A>();
+    first.Startup(1);
+    A* const instance = &A::Get();
+
+    ServiceRegistry second;
+    second.Register<B>();
+    second.Register<A>();
+    EXPECT_TRUE(Throws<std::logic_error>([&] { second.Startup(1); }));
+    EXPECT_TRUE(A::IsRunning() && &A::Get() == instance);
+    EXPECT_TRUE(!B::IsRunning());
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+/**
+ * A single transition rule: 'trigger' moves the machine from 'from' to 'to'.
+ */
+template <typename TState, typename TTrigger>
+struct Transition
+{
+	TState from;
+	TTrigger trigger;
+	TState to;
+};
+
+/**
+ * Dense transition table, indexed by [state][trigger].
+ * States and triggers are enums with a one-byte underlying type, numbered
+ * from 0 to 'NumStates - 1' and 'NumTriggers - 1'. The table is built from a
+ * list of rules in a constexpr context, so an out-of-range or duplicate rule
+ * fails to compile:
+ *
+ *	constexpr auto table = TransitionTable<EState, ETrigger, 5, 9>(rules);
+ *
+ * A trigger without a rule for the current state leaves the state unchanged.
+ */
+template <typename TState, typename TTrigger, std::size_t NumStates, std::size_t NumTriggers>
+class TransitionTable
+{
+public:
+	static_assert(sizeof(TState) == 1 && sizeof(TTrigger) == 1, "States and triggers must be one byte");
+	static_assert(NumStates < 0xFF, "0xFF is reserved for missing transitions");
+
+	using Rule = Transition<TState, TTrigger>;
+
+	template <std::size_t NumRules>
+	constexpr explicit TransitionTable(const Rule (&rules)[NumRules])
+		: m_next{ }
+	{
+		for (auto& next : m_next)
+		{
+			next = kNone;
+		}
+		for (const Rule& rule : rules)
+		{
+			if (Index(rule.from) >= NumStates || Index(rule.to) >= NumStates || Index(rule.trigger) >= NumTriggers)
+			{
+				throw std::logic_error("Transition rule out of range");
+			}
+			std::uint8_t& next = m_next[Index(rule.from) * NumTriggers + Index(rule.trigger)];
+			if (next != kNone)
+			{
+				throw std::logic_error("Duplicate transition rule");
+			}
+			next = static_cast<std::uint8_t>(rule.to);
+		}
+	}
+
+	constexpr bool IsValid(TState state, TTrigger trigger) const
+	{
+		return Index(state) < NumStates && Index(trigger) < NumTriggers
+			&& m_next[Index(state) * NumTriggers + Index(trigger)] != kNone;
+	}
+
+	// The state after 'trigger', or 'state' itself if there is no such transition.
+	constexpr TState Next(TState state, TTrigger trigger) const
+	{
+		return IsValid(state, trigger) ? static_cast<TState>(m_next[Index(state) * NumTriggers + Index(trigger)]) : state;
+	}
+
+	// Advances 'count' independent machines: states[i] = Next(states[i], triggers[i]).
+	void Step(TState* states, const TTrigger* triggers, std::size_t count) const
+	{
+		auto* current = reinterpret_cast<std::uint8_t*>(states);
+		const auto* input = reinterpret_cast<const std::uint8_t*>(triggers);
+		std::size_t i = 0;
+
+#if defined(__AVX2__)
+		const __m256i maxState = _mm256_set1_epi32(NumStates - 1);
+		const __m256i maxTrigger = _mm256_set1_epi32(NumTriggers - 1);
+		const __m256i rowSize = _mm256_set1_epi32(NumTriggers);
+		const __m256i byteMask = _mm256_set1_epi32(0xFF);
+		const __m256i none = _mm256_set1_epi32(kNone);
+		const int* table = reinterpret_cast<const int*>(m_next.data());
+
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256i state = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(current + i)));
+			const __m256i trigger = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i)));
+
+			// Out-of-range lanes are clamped for the gather and masked out afterwards.
+			const __m256i clampedState = _mm256_min_epu32(state, maxState);
+			const __m256i clampedTrigger = _mm256_min_epu32(trigger, maxTrigger);
+			const __m256i outOfRange = _mm256_or_si256(
+				_mm256_xor_si256(_mm256_cmpeq_epi32(state, clampedState), _mm256_set1_epi32(-1)),
+				_mm256_xor_si256(_mm256_cmpeq_epi32(trigger, clampedTrigger), _mm256_set1_epi32(-1)));
+
+			const __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(clampedState, rowSize), clampedTrigger);
+			const __m256i next = _mm256_and_si256(_mm256_i32gather_epi32(table, index, 1), byteMask);
+			const __m256i keep = _mm256_or_si256(outOfRange, _mm256_cmpeq_epi32(next, none));
+			const __m256i result = _mm256_blendv_epi8(next, state, keep);
+
+			const __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(current + i), _mm_packus_epi16(words, words));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			if (current[i] < NumStates && input[i] < NumTriggers)
+			{
+				const std::uint8_t next = m_next[current[i] * NumTriggers + input[i]];
+				current[i] = next != kNone ? next : current[i];
+			}
+		}
+	}
+
+	static constexpr std::size_t GetStateCount() { return NumStates; }
+	static constexpr std::size_t GetTriggerCount() { return NumTriggers; }
+
+private:
+	static constexpr std::uint8_t kNone = 0xFF;
+
+	template <typename TEnum>
+	static constexpr std::size_t Index(TEnum value)
+	{
+		return static_cast<std::size_t>(value);
+	}
+
+	// Padded so the 4-byte gathers above never read past the end.
+	std::array<std::uint8_t, NumStates * NumTriggers + 3> m_next;
+};
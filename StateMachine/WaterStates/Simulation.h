@@ -0,0 +1,225 @@
+#pragma once
+
+#include "WaterStates.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A trigger value outside the table, used when a particle does not change.
+constexpr ETrigger kNoTrigger = static_cast<ETrigger>(0xFF);
+
+/**
+ * Picks the trigger for a particle in 'state' at the given temperature (°C)
+ * and pressure (atm). Only triggers that are valid in 'state' are returned.
+ */
+inline ETrigger DeriveTrigger(EState state, float temperature, float pressure)
+{
+	constexpr float kTriplePressure = 0.006f;	// Below it liquid water can not exist.
+	constexpr float kBoilingPoint = 100.0f;
+	constexpr float kIonizationPoint = 5000.0f;
+
+	switch (state)
+	{
+		case EState::Liquid:
+			if (temperature <= 0.0f) return ETrigger::Freezing;
+			if (temperature >= kBoilingPoint || pressure < kTriplePressure) return ETrigger::Vaporiaztion;
+			break;
+		case EState::Ice:
+			if (temperature > 0.0f) return pressure < kTriplePressure ? ETrigger::Sublimation : ETrigger::Melting;
+			break;
+		case EState::Vapor:
+			if (temperature >= kIonizationPoint) return ETrigger::Ionization;
+			if (temperature <= 0.0f) return ETrigger::Deposition;
+			if (temperature < kBoilingPoint && pressure >= kTriplePressure) return ETrigger::Condensation;
+			break;
+		case EState::Plasma:
+			if (temperature < kIonizationPoint) return ETrigger::Deionization;
+			break;
+		default: break;
+	}
+	return kNoTrigger;
+}
+
+/**
+ * Per-tick histograms: particles per state after the tick, and how many
+ * particles took each trigger during it.
+ */
+struct TickStatistics
+{
+	std::array<std::uint64_t, WaterTransitionTable::GetStateCount()> states{ };
+	std::array<std::uint64_t, WaterTransitionTable::GetTriggerCount()> transitions{ };
+
+	TickStatistics& operator+=(const TickStatistics& other)
+	{
+		for (std::size_t i = 0; i < states.size(); ++i) states[i] += other.states[i];
+		for (std::size_t i = 0; i < transitions.size(); ++i) transitions[i] += other.transitions[i];
+		return *this;
+	}
+};
+
+/**
+ * Runs the water state machine for a large population of particles.
+ * States are stored one byte per particle. Each tick, the particles are
+ * split into fixed-size chunks which the worker threads claim in turn;
+ * every worker derives the triggers for its chunk from the field values,
+ * steps it through the transition table and fills its own histogram. The
+ * histograms are summed once all workers are done, so there are no shared
+ * counters and the result does not depend on the thread count.
+ * The workers and their trigger buffers live as long as the simulation, so
+ * a tick neither starts threads nor allocates.
+ */
+class ParticleSimulation
+{
+public:
+	ParticleSimulation(std::size_t particleCount, EState initialState,
+		std::size_t threadCount = std::thread::hardware_concurrency(), std::size_t chunkSize = 16 * 1024)
+		: m_states(particleCount, initialState)
+		, m_chunkSize(std::max<std::size_t>(1, chunkSize))
+		, m_triggers(std::max<std::size_t>(1, threadCount), std::vector<ETrigger>(m_chunkSize))
+		, m_workerStatistics(m_triggers.size())
+	{
+		// The thread calling 'Tick' is worker 0.
+		for (std::size_t i = 1; i < m_triggers.size(); ++i)
+		{
+			m_workers.emplace_back([this, i] { WorkerLoop(i); });
+		}
+	}
+
+	ParticleSimulation(const ParticleSimulation&) = delete;
+	ParticleSimulation& operator=(const ParticleSimulation&) = delete;
+
+	~ParticleSimulation()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_wake.notify_all();
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	/**
+	 * Advances every particle by one tick. 'temperature[i]' and 'pressure[i]'
+	 * are the field values sampled at particle i.
+	 */
+	const TickStatistics& Tick(const float* temperature, const float* pressure)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_temperature = temperature;
+			m_pressure = pressure;
+			m_nextChunk.store(0, std::memory_order_relaxed);
+			m_busyWorkers = m_workers.size();
+			++m_generation;
+		}
+		m_wake.notify_all();
+
+		RunChunks(0);
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_done.wait(lock, [this] { return m_busyWorkers == 0; });
+		}
+
+		m_statistics = TickStatistics{ };
+		for (const auto& local : m_workerStatistics)
+		{
+			m_statistics += local.value;
+		}
+		return m_statistics;
+	}
+
+	const std::vector<EState>& GetStates() const { return m_states; }
+	const TickStatistics& GetStatistics() const { return m_statistics; }
+
+private:
+	// Padded so neighbouring workers never share a cache line.
+	struct alignas(64) WorkerStatistics
+	{
+		TickStatistics value;
+	};
+
+	void WorkerLoop(std::size_t self)
+	{
+		std::size_t generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [&] { return m_stopping || m_generation != generation; });
+				if (m_stopping)
+				{
+					return;
+				}
+				generation = m_generation;
+			}
+
+			RunChunks(self);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_busyWorkers == 0)
+			{
+				m_done.notify_one();
+			}
+		}
+	}
+
+	void RunChunks(std::size_t self)
+	{
+		const std::size_t chunkCount = (m_states.size() + m_chunkSize - 1) / m_chunkSize;
+		ETrigger* triggers = m_triggers[self].data();
+		TickStatistics& local = m_workerStatistics[self].value;
+		local = TickStatistics{ };
+
+		for (std::size_t chunk = m_nextChunk++; chunk < chunkCount; chunk = m_nextChunk++)
+		{
+			const std::size_t first = chunk * m_chunkSize;
+			const std::size_t count = std::min(m_chunkSize, m_states.size() - first);
+			EState* states = m_states.data() + first;
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				triggers[i] = DeriveTrigger(states[i], m_temperature[first + i], m_pressure[first + i]);
+				if (triggers[i] != kNoTrigger)
+				{
+					++local.transitions[static_cast<std::size_t>(triggers[i])];
+				}
+			}
+
+			kWaterTransitions.Step(states, triggers, count);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				++local.states[static_cast<std::size_t>(states[i])];
+			}
+		}
+	}
+
+	std::vector<EState> m_states;
+	std::size_t m_chunkSize;
+	std::vector<std::vector<ETrigger>> m_triggers;	// Per worker, one chunk each.
+	std::vector<WorkerStatistics> m_workerStatistics;
+	TickStatistics m_statistics;
+
+	// The current tick, published to the workers under 'm_mutex'.
+	const float* m_temperature = nullptr;
+	const float* m_pressure = nullptr;
+	std::atomic<std::size_t> m_nextChunk{ 0 };
+
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	std::size_t m_generation = 0;
+	std::size_t m_busyWorkers = 0;
+	bool m_stopping = false;
+};
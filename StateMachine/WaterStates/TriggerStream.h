@@ -0,0 +1,143 @@
+#pragma once
+
+#include "WaterStates.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Outcome of replaying a stream of triggers.
+ */
+struct ReplayResult
+{
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	EState finalState;
+	std::size_t applied = 0;	// Triggers consumed, including the one reaching 'Exit'.
+	std::array<std::uint64_t, WaterTransitionTable::GetTriggerCount()> transitions{ };
+
+	// Index of the first trigger that is not an 'ETrigger' value or has no
+	// transition from the state the machine is in, or 'npos'.
+	std::size_t firstInvalid = npos;
+};
+
+/**
+ * Index of the first byte that is not a valid 'ETrigger' value, or 'count'.
+ * The stream is scanned in blocks without an early exit per byte, which
+ * lets the compiler vectorize the check.
+ */
+inline std::size_t FindInvalidTrigger(const std::uint8_t* triggers, std::size_t count)
+{
+	constexpr std::uint8_t kTriggerCount = static_cast<std::uint8_t>(WaterTransitionTable::GetTriggerCount());
+	constexpr std::size_t kBlock = 64;
+
+	std::size_t i = 0;
+	for (; i + kBlock <= count; i += kBlock)
+	{
+		std::uint8_t invalid = 0;
+		for (std::size_t j = 0; j < kBlock; ++j)
+		{
+			invalid |= triggers[i + j] >= kTriggerCount;
+		}
+		if (invalid)
+		{
+			break;
+		}
+	}
+	for (; i < count; ++i)
+	{
+		if (triggers[i] >= kTriggerCount)
+		{
+			return i;
+		}
+	}
+	return count;
+}
+
+/**
+ * Applies 'triggers' to a single machine starting in 'initial', until the
+ * stream ends, the machine exits, or a trigger is invalid.
+ */
+inline ReplayResult ReplayTriggers(EState initial, const std::uint8_t* triggers, std::size_t count)
+{
+	ReplayResult result{ initial };
+	const std::size_t valid = FindInvalidTrigger(triggers, count);
+
+	EState state = initial;
+	std::size_t i = 0;
+	for (; i < valid && state != EState::Exit; ++i)
+	{
+		const ETrigger trigger = static_cast<ETrigger>(triggers[i]);
+		if (!kWaterTransitions.IsValid(state, trigger))
+		{
+			break;
+		}
+		++result.transitions[triggers[i]];
+		state = kWaterTransitions.Next(state, trigger);
+	}
+
+	result.finalState = state;
+	result.applied = i;
+	if (state != EState::Exit && i < count)
+	{
+		result.firstInvalid = i;
+	}
+	return result;
+}
+
+/**
+ * Parses a text trace of decimal 'ETrigger' values separated by whitespace
+ * or commas. Values above 255 are stored as 0xFF so that they fail
+ * validation. Parsing stops at the first character that is neither; its
+ * byte offset is written to 'errorOffset' (or 'ReplayResult::npos').
+ */
+inline std::vector<std::uint8_t> ParseTextTriggers(const std::uint8_t* text, std::size_t size, std::size_t& errorOffset)
+{
+	std::vector<std::uint8_t> triggers;
+	triggers.reserve(size / 2);
+	errorOffset = ReplayResult::npos;
+
+	std::size_t i = 0;
+	while (i < size)
+	{
+		const std::uint8_t c = text[i];
+		if (c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ',')
+		{
+			++i;
+			continue;
+		}
+		if (c < '0' || c > '9')
+		{
+			errorOffset = i;
+			break;
+		}
+
+		unsigned value = 0;
+		for (; i < size && text[i] >= '0' && text[i] <= '9'; ++i)
+		{
+			value = value < 256 ? value * 10 + (text[i] - '0') : value;
+		}
+		triggers.push_back(static_cast<std::uint8_t>(value < 256 ? value : 0xFF));
+	}
+	return triggers;
+}
+
+// Byte offset of the 'index'-th value in a text trace, or 'size' past the end.
+inline std::size_t FindTextTriggerOffset(const std::uint8_t* text, std::size_t size, std::size_t index)
+{
+	std::size_t token = 0;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const bool digit = text[i] >= '0' && text[i] <= '9';
+		if (digit && (i == 0 || text[i - 1] < '0' || text[i - 1] > '9'))
+		{
+			if (token++ == index)
+			{
+				return i;
+			}
+		}
+	}
+	return size;
+}
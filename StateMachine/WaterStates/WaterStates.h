@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../StateMachine.h"
+
+#include <cstdint>
+#include <iostream>
+
+// The states water can exist in.
+enum class EState : std::uint8_t
+{
+	Liquid,
+	Vapor,
+	Ice,
+	Plasma,
+	Exit,
+};
+
+// Transitions, Actions, Triggers...
+enum class ETrigger : std::uint8_t
+{
+	Melting,
+	Freezing,
+	Sublimation,
+	Deposition,
+	Vaporiaztion,
+	Condensation,
+	Ionization,
+	Deionization,
+	Exit
+};
+
+inline std::ostream& operator<<(std::ostream &os, const ETrigger &trigger)
+{
+	switch (trigger)
+	{
+		case ETrigger::Melting:		os << "Melting";	break;	
+		case ETrigger::Freezing:	os << "Freezing";	break;
+		case ETrigger::Sublimation:	os << "Sublimation";	break;
+		case ETrigger::Deposition:	os << "Deposition";	break;
+		case ETrigger::Vaporiaztion:	os << "Vaporiaztion";	break;
+		case ETrigger::Condensation:	os << "Condensation";	break;
+		case ETrigger::Ionization:	os << "Ionization";	break;
+		case ETrigger::Deionization:	os << "Deionization";	break;
+		case ETrigger::Exit:		os << "Exit";		break;
+		default: break;
+	}
+	return os;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const EState& state)
+{
+	switch (state)
+	{
+		case EState::Liquid:	os << "Liquid";	break;
+		case EState::Vapor:	os << "Vapor";	break;
+		case EState::Ice:	os << "Ice";	break;
+		case EState::Plasma:	os << "Plasma";	break;
+		case EState::Exit:	os << "Exit";	break;
+		default: break;
+	}
+	return os;
+}
+
+using WaterTransitionTable = TransitionTable<EState, ETrigger, 5, 9>;
+
+// Defining the transitions rules: 
+// { main state, trigger, resulting state }
+constexpr WaterTransitionTable::Rule kWaterRules[] = {
+	{ EState::Liquid, ETrigger::Freezing, EState::Ice },
+	{ EState::Liquid, ETrigger::Vaporiaztion, EState::Vapor },
+	{ EState::Liquid, ETrigger::Exit, EState::Exit },
+
+	{ EState::Ice, ETrigger::Melting, EState::Liquid },
+	{ EState::Ice, ETrigger::Sublimation, EState::Vapor },
+	{ EState::Ice, ETrigger::Exit, EState::Exit },
+
+	{ EState::Vapor, ETrigger::Deposition, EState::Ice },
+	{ EState::Vapor, ETrigger::Ionization, EState::Plasma },
+	{ EState::Vapor, ETrigger::Condensation, EState::Liquid },
+	{ EState::Vapor, ETrigger::Exit, EState::Exit },
+
+	{ EState::Plasma, ETrigger::Deionization, EState::Vapor },
+	{ EState::Plasma, ETrigger::Exit, EState::Exit },
+};
+
+constexpr WaterTransitionTable kWaterTransitions{ kWaterRules };
+
+static_assert(kWaterTransitions.Next(EState::Ice, ETrigger::Melting) == EState::Liquid, "Ice melts into liquid");
+static_assert(!kWaterTransitions.IsValid(EState::Plasma, ETrigger::Freezing), "Plasma can not freeze");
@@ -0,0 +1,45 @@
+#include "WaterStates.h"
+#include "Simulation.h"
+#include "TriggerStream.h"
+#include "../../TestSupport/AllocationTracker.h"
+
+#include <vector>
+
+
+TEST(WaterStates, SteppingDoesNotAllocate)
+{
+	std::vector<EState> states(1000, EState::Liquid);
+	std::vector<ETrigger> triggers(1000, ETrigger::Vaporiaztion);
+
+	EXPECT_NO_ALLOCATIONS(kWaterTransitions.Step(states.data(), triggers.data(), states.size()));
+	EXPECT_TRUE(states[999] == EState::Vapor);
+}
+
+TEST(WaterStates, ReplayDoesNotAllocate)
+{
+	// A valid walk through the rules: Liquid -> Vapor -> Ice -> Liquid, repeated.
+	const ETrigger cycle[] = { ETrigger::Vaporiaztion, ETrigger::Deposition, ETrigger::Melting };
+	std::vector<std::uint8_t> trace;
+	for (std::size_t i = 0; i < 999; ++i)
+	{
+		trace.push_back(static_cast<std::uint8_t>(cycle[i % 3]));
+	}
+	ReplayResult result{ EState::Liquid };
+
+	EXPECT_NO_ALLOCATIONS(result = ReplayTriggers(EState::Liquid, trace.data(), trace.size()));
+	EXPECT_TRUE(result.finalState == EState::Liquid);
+	EXPECT_TRUE(result.applied == trace.size());
+	EXPECT_TRUE(result.firstInvalid == ReplayResult::npos);
+}
+
+TEST(WaterStates, SimulationTickDoesNotAllocate)
+{
+	// Workers and buffers are created with the simulation, not per tick.
+	ParticleSimulation simulation{ 10000, EState::Ice, 4, 1000 };
+	const std::vector<float> temperature(10000, 20.0f);
+	const std::vector<float> pressure(10000, 1.0f);
+
+	EXPECT_NO_ALLOCATIONS(simulation.Tick(temperature.data(), pressure.data()));
+	EXPECT_NO_ALLOCATIONS(simulation.Tick(temperature.data(), pressure.data()));
+	EXPECT_TRUE(simulation.GetStates()[9999] == EState::Liquid);
+}
@@ -0,0 +1,133 @@
+/*
+	Benchmarks for the water state machine.
+	Measures bulk stepping of independent machines, each taking one valid
+	transition, through the dense transition table against the per-state
+	vector of rules used before, and replaying one long trigger trace.
+
+	Updated: 2026-10-19
+	Author: Jonathan Helsing [github.com/Jonathan-source]
+*/
+
+#include "WaterStates.h"
+#include "TriggerStream.h"
+#include "../../Benchmarks/Benchmark.h"
+
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// The original representation: a hash lookup and a linear scan per step.
+using RuleMap = std::unordered_map<EState, std::vector<std::pair<ETrigger, EState>>>;
+
+RuleMap MakeRuleMap()
+{
+	RuleMap rules;
+	for (const auto& rule : kWaterRules)
+	{
+		rules[rule.from].emplace_back(rule.trigger, rule.to);
+	}
+	return rules;
+}
+
+// A random trigger that is valid in 'state', never 'Exit'.
+ETrigger PickTrigger(EState state, std::mt19937& rng)
+{
+	ETrigger options[WaterTransitionTable::GetTriggerCount()]{};
+	std::size_t count = 0;
+	for (const auto& rule : kWaterRules)
+	{
+		if (rule.from == state && rule.trigger != ETrigger::Exit)
+		{
+			options[count++] = rule.trigger;
+		}
+	}
+	return options[rng() % count];
+}
+
+// A random walk through the rules, never taking 'Exit'.
+std::vector<std::uint8_t> MakeTrace(std::size_t length, std::mt19937& rng)
+{
+	std::vector<std::uint8_t> trace;
+	trace.reserve(length);
+
+	EState state = EState::Liquid;
+	while (trace.size() < length)
+	{
+		const ETrigger trigger = PickTrigger(state, rng);
+		trace.push_back(static_cast<std::uint8_t>(trigger));
+		state = kWaterTransitions.Next(state, trigger);
+	}
+	return trace;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSuite suite{ ParseBenchmarkOptions(argc, argv) };
+	suite.PrintHeader();
+
+	constexpr std::size_t kMachines = 4096;
+
+	std::mt19937 rng{ 42 };
+	std::vector<EState> initial(kMachines);
+	std::vector<ETrigger> triggers(kMachines);
+	for (std::size_t i = 0; i < kMachines; ++i)
+	{
+		initial[i] = static_cast<EState>(rng() % 4);
+		triggers[i] = PickTrigger(initial[i], rng);
+	}
+
+	// Every iteration starts again from 'initial', so each machine takes a
+	// real transition instead of stepping an already moved state. Both
+	// representations must agree before their speed is compared.
+	std::vector<EState> mapped = initial;
+	std::vector<EState> states = initial;
+	RuleMap rules = MakeRuleMap();
+	auto stepRuleMap = [&]
+	{
+		mapped = initial;
+		for (std::size_t i = 0; i < kMachines; ++i)
+		{
+			for (const auto& rule : rules[mapped[i]])
+			{
+				if (rule.first == triggers[i])
+				{
+					mapped[i] = rule.second;
+					break;
+				}
+			}
+		}
+	};
+	auto stepTable = [&]
+	{
+		states = initial;
+		kWaterTransitions.Step(states.data(), triggers.data(), kMachines);
+	};
+	stepRuleMap();
+	stepTable();
+	if (states != mapped || states == initial)
+	{
+		std::fprintf(stderr, "The transition table and the rule map disagree\n");
+		return 1;
+	}
+
+	suite.Run("rule map step/4096", stepRuleMap);
+	suite.Run(std::string("TransitionTable::Step/4096") +
+#if defined(__AVX2__)
+		" (AVX2)",
+#else
+		" (scalar)",
+#endif
+		[&] { stepTable(); DoNotOptimize(states.data()); });
+
+	const std::vector<std::uint8_t> trace = MakeTrace(1000000, rng);
+	suite.Run("ReplayTriggers/1000000", [&] { DoNotOptimize(ReplayTriggers(EState::Liquid, trace.data(), trace.size())); });
+
+	return suite.Finish();
+}
@@ -2,98 +2,138 @@
 	In this demo, I have applied the state machine design pattern to simulate the
 	transition between the several states water can exist in ( liquid, vapor, solid, and plasma ).
 	I used the UML state machine diagram, that was uploaded with this code, to create the transition rules.
-
-	Updated: 2022-06-05
+	The rules are compiled into a dense [state][trigger] table (see StateMachine.h), which also
+	lets millions of independent machines be stepped in one call.
+	Run with '--simulate [particles] [ticks] [threads]' to drive a whole population of water
+	particles from temperature and pressure fields instead of the interactive demo, or with
+	'--replay <file> [binary|text]' to apply a recorded trace of triggers (one 'ETrigger' value
+	per byte, or decimal values in text) and report the final state and transition counts.
+
+	Updated: 2026-10-19
 	Author: Jonathan Helsing [github.com/Jonathan-source]
 */
 
+#include "WaterStates.h"
+#include "Simulation.h"
+#include "TriggerStream.h"
+#include "../../Platform/MappedFile.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
-#include <unordered_map>
 
-// The states water can exist in.
-enum class EState
-{
-	Liquid,
-	Vapor,
-	Ice,
-	Plasma,
-	Exit,
-};
-
-// Transitions, Actions, Triggers...
-enum class ETrigger
-{
-	Melting,
-	Freezing,
-	Sublimation,
-	Deposition,
-	Vaporiaztion,
-	Condensation,
-	Ionization,
-	Deionization,
-	Exit
-};
-
-inline std::ostream& operator<<(std::ostream &os, const ETrigger &trigger)
+
+// Sweeps a population of particles from ice to plasma and back.
+int RunSimulation(std::size_t particleCount, std::size_t tickCount, std::size_t threadCount)
 {
-	switch (trigger)
+	ParticleSimulation simulation{ particleCount, EState::Ice, threadCount };
+	std::vector<float> temperature(particleCount);
+	std::vector<float> pressure(particleCount);
+
+	std::cout << "tick  temp    liquid     vapor       ice    plasma  transitions\n";
+	for (std::size_t tick = 0; tick < tickCount; ++tick)
 	{
-		case ETrigger::Melting:		os << "Melting";	break;	
-		case ETrigger::Freezing:	os << "Freezing";	break;
-		case ETrigger::Sublimation:	os << "Sublimation";	break;
-		case ETrigger::Deposition:	os << "Deposition";	break;
-		case ETrigger::Vaporiaztion:	os << "Vaporiaztion";	break;
-		case ETrigger::Condensation:	os << "Condensation";	break;
-		case ETrigger::Ionization:	os << "Ionization";	break;
-		case ETrigger::Deionization:	os << "Deionization";	break;
-		case ETrigger::Exit:		os << "Exit";		break;
-		default: break;
+		// A global heat wave with some spatial variation, and pockets of near vacuum.
+		const float phase = static_cast<float>(tick) / static_cast<float>(tickCount);
+		const float base = -50.0f + 5200.0f * std::sin(3.14159265f * phase);
+		for (std::size_t i = 0; i < particleCount; ++i)
+		{
+			temperature[i] = base + 80.0f * std::sin(static_cast<float>(i) * 0.001f);
+			pressure[i] = (i % 1000) < 10 ? 0.001f : 1.0f;
+		}
+
+		const TickStatistics& stats = simulation.Tick(temperature.data(), pressure.data());
+
+		std::uint64_t transitions = 0;
+		for (const auto count : stats.transitions) transitions += count;
+
+		std::printf("%4zu %5.0f %9llu %9llu %9llu %9llu %12llu\n", tick, base,
+			static_cast<unsigned long long>(stats.states[static_cast<std::size_t>(EState::Liquid)]),
+			static_cast<unsigned long long>(stats.states[static_cast<std::size_t>(EState::Vapor)]),
+			static_cast<unsigned long long>(stats.states[static_cast<std::size_t>(EState::Ice)]),
+			static_cast<unsigned long long>(stats.states[static_cast<std::size_t>(EState::Plasma)]),
+			static_cast<unsigned long long>(transitions));
 	}
-	return os;
+
+	return 0;
 }
 
-inline std::ostream& operator<<(std::ostream& os, const EState& state)
+
+// Applies a recorded trigger trace, starting from 'Liquid'.
+int RunReplay(const char* path, bool isText)
 {
-	switch (state)
+	try
+	{
+		const MappedFile file{ path };
+		const auto start = std::chrono::steady_clock::now();
+
+		const std::uint8_t* triggers = file.GetData();
+		std::size_t count = file.GetSize();
+		std::size_t parseError = ReplayResult::npos;
+		std::vector<std::uint8_t> parsed;
+		if (isText)
+		{
+			parsed = ParseTextTriggers(file.GetData(), file.GetSize(), parseError);
+			triggers = parsed.data();
+			count = parsed.size();
+		}
+
+		const ReplayResult result = ReplayTriggers(EState::Liquid, triggers, count);
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		// Report the offset into the file, not into the parsed values.
+		std::size_t invalidOffset = result.firstInvalid;
+		if (isText && invalidOffset != ReplayResult::npos)
+		{
+			invalidOffset = FindTextTriggerOffset(file.GetData(), file.GetSize(), invalidOffset);
+		}
+		else if (isText && result.finalState != EState::Exit)
+		{
+			invalidOffset = parseError;
+		}
+
+		std::cout << "Final state: " << result.finalState << "\n";
+		std::cout << "Triggers applied: " << result.applied << " of " << count << "\n";
+		for (std::size_t trigger = 0; trigger < result.transitions.size(); ++trigger)
+		{
+			std::cout << "  " << static_cast<ETrigger>(trigger) << ": " << result.transitions[trigger] << "\n";
+		}
+		if (invalidOffset != ReplayResult::npos)
+		{
+			std::cout << "First invalid trigger at offset " << invalidOffset << "\n";
+		}
+		std::printf("Replayed in %.3f s (%.0f M triggers/s)\n", seconds, result.applied / seconds / 1e6);
+
+		return invalidOffset == ReplayResult::npos ? 0 : 1;
+	}
+	catch (const std::runtime_error& error)
 	{
-		case EState::Liquid:	os << "Liquid";	break;
-		case EState::Vapor:	os << "Vapor";	break;
-		case EState::Ice:	os << "Ice";	break;
-		case EState::Plasma:	os << "Plasma";	break;
-		default: break;
+		// The file could not be opened or mapped.
+		std::cerr << error.what() << "\n";
+		return 1;
 	}
-	return os;
 }
 
 
-int main()
+int main(int argc, char* argv[])
 {
-	typedef std::unordered_map<EState, std::vector<std::pair<ETrigger, EState>>> TransitionTable;
-	TransitionTable rules{ };
-
-	// Defining the transitions rules: 
-	// [main state]{ available triggers &  their resulting states }
-	rules[EState::Liquid] = {
-		{ ETrigger::Freezing, EState::Ice },
-		{ ETrigger::Vaporiaztion, EState::Vapor },
-		{ ETrigger::Exit, EState::Exit }
-	};
-	rules[EState::Ice] = {
-		{ ETrigger::Melting, EState::Liquid },
-		{ ETrigger::Sublimation, EState::Vapor },
-		{ ETrigger::Exit, EState::Exit }
-	};
-	rules[EState::Vapor] = {
-		{ ETrigger::Deposition, EState::Ice },
-		{ ETrigger::Ionization, EState::Plasma },
-		{ ETrigger::Condensation, EState::Liquid },
-		{ ETrigger::Exit, EState::Exit }
-	};
-	rules[EState::Plasma] = {
-		{ ETrigger::Deionization, EState::Vapor },
-		{ ETrigger::Exit, EState::Exit }
-	};
+	if (argc > 2 && std::strcmp(argv[1], "--replay") == 0)
+	{
+		return RunReplay(argv[2], argc > 3 && std::strcmp(argv[3], "text") == 0);
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "--simulate") == 0)
+	{
+		const std::size_t particles = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+		const std::size_t ticks = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 20;
+		const std::size_t threads = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : std::thread::hardware_concurrency();
+		return RunSimulation(particles, ticks, threads);
+	}
 
 	EState currentState{ EState::Liquid };
 	EState exitState{ EState::Exit };
@@ -103,23 +143,36 @@ int main()
 	{
 		std::cout << "The water is currently in '" << currentState << "' state\n";
 
+		// The triggers available in the current state, in the order of the rules.
+		std::vector<ETrigger> options;
+		for (const auto& rule : kWaterRules)
+		{
+			if (rule.from == currentState)
+			{
+				options.push_back(rule.trigger);
+			}
+		}
+
 	option_input: // It's just a demo, and hopefully my teacher will not see this...
 
 		int index{ 0 };
-		for (const auto& item : rules[currentState])
+		for (const auto& item : options)
 		{
-			std::cout << index++ << ". " << item.first << "\n";
+			std::cout << index++ << ". " << item << "\n";
 		}
 
 		int input{ };
-		std::cin >> input;
-		if (input < 0 || (input + 1) > rules[currentState].size())
+		if (!(std::cin >> input))
+		{
+			break; // End of input.
+		}
+		if (input < 0 || static_cast<std::size_t>(input) >= options.size())
 		{
 			std::cout << "Invalid option. Please try again.\n";
 			goto option_input;
 		}
 
-		currentState = rules[currentState][input].second;
+		currentState = kWaterTransitions.Next(currentState, options[input]);
 		if (currentState == exitState) isRunning = false;
 	}
 
@@ -0,0 +1,56 @@
+#include "WaterStates.h"
+#include "Simulation.h"
+#include "../../TestSupport/AllocationTracker.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+// States and histograms must not depend on the thread count or on which
+// worker claimed which chunk.
+TEST(ParticleSimulation, ThreadCountDoesNotChangeTheResult)
+{
+	constexpr std::size_t kParticles = 100000;
+	constexpr std::size_t kChunkSize = 1000;
+
+	ParticleSimulation serial{ kParticles, EState::Ice, 1, kChunkSize };
+	ParticleSimulation parallel{ kParticles, EState::Ice, 4, kChunkSize };
+	ParticleSimulation uneven{ kParticles, EState::Ice, 3, kChunkSize + 7 };
+
+	std::mt19937 rng{ 32 };
+	std::vector<float> temperature(kParticles);
+	std::vector<float> pressure(kParticles);
+	bool identical = true;
+	for (int tick = 0; tick < 20 && identical; ++tick)
+	{
+		for (std::size_t i = 0; i < kParticles; ++i)
+		{
+			temperature[i] = static_cast<float>(rng() % 6000) - 50.0f;
+			pressure[i] = (rng() % 100) < 5 ? 0.001f : 1.0f;
+		}
+
+		const TickStatistics expected = serial.Tick(temperature.data(), pressure.data());
+		for (ParticleSimulation* simulation : { &parallel, &uneven })
+		{
+			const TickStatistics& actual = simulation->Tick(temperature.data(), pressure.data());
+			identical = identical
+				&& actual.states == expected.states
+				&& actual.transitions == expected.transitions
+				&& simulation->GetStates() == serial.GetStates();
+		}
+	}
+	EXPECT_TRUE(identical);
+}
+
+TEST(ParticleSimulation, HistogramsCountEveryParticle)
+{
+	constexpr std::size_t kParticles = 5000;
+	ParticleSimulation simulation{ kParticles, EState::Ice, 2, 64 };
+	const std::vector<float> temperature(kParticles, 20.0f);
+	const std::vector<float> pressure(kParticles, 1.0f);
+
+	const TickStatistics& stats = simulation.Tick(temperature.data(), pressure.data());
+	EXPECT_TRUE(stats.states[static_cast<std::size_t>(EState::Liquid)] == kParticles);
+	EXPECT_TRUE(stats.transitions[static_cast<std::size_t>(ETrigger::Melting)] == kParticles);
+}
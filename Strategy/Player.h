@@ -0,0 +1,34 @@
+#pragma once
+
+#include "PlayerSkills.h"
+
+#include <string>
+#include <unordered_map>
+
+
+class Player {
+public:
+    Player() : m_pCurrentSkill(nullptr) {}
+    virtual ~Player() { m_skillMap.clear(); }
+
+    void UseSkill() {
+        if (m_pCurrentSkill) {
+            m_pCurrentSkill->Use();
+        }
+    }
+
+    void ClearSkill() { m_pCurrentSkill = nullptr; }
+
+    void SetSkill(const std::string& name) {
+        const auto skill = m_skillMap.find(name);
+        m_pCurrentSkill = skill != m_skillMap.end() ? skill->second : nullptr;
+    }
+
+    void AddSkill(const std::string& name, IPlayerSkill* pSkill) {
+        m_skillMap[name] = pSkill;
+    }
+
+private:
+    std::unordered_map<std::string, IPlayerSkill*> m_skillMap;
+    IPlayerSkill* m_pCurrentSkill;
+};
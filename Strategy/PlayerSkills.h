@@ -0,0 +1,43 @@
+#pragma once
+
+#include <iostream>
+
+
+class IPlayerSkill {
+public:
+    virtual ~IPlayerSkill() {}
+    virtual void Use(/* Player &player ? */) = 0;
+};
+
+
+class RestoreHP : public IPlayerSkill {
+public:
+    RestoreHP() = default;
+    virtual ~RestoreHP() = default;
+
+    void Use() override {
+        std::cout << "Using RestoreHP" << std::endl;
+    }
+};
+
+
+class FrostBolt : public IPlayerSkill {
+public:
+    FrostBolt() = default;
+    virtual ~FrostBolt() = default;
+
+    void Use() override {
+        std::cout << "Using FrostBolt" << std::endl;
+    }
+};
+
+
+class Flamestrike : public IPlayerSkill {
+public:
+    Flamestrike() = default;
+    virtual ~Flamestrike() = default;
+
+    void Use() override {
+        std::cout << "Using Flamestrike" << std::endl;
+    }
+};
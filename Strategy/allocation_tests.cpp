@@ -0,0 +1,28 @@
+#include "Player.h"
+#include "../TestSupport/AllocationTracker.h"
+
+
+class NopSkill : public IPlayerSkill {
+public:
+    void Use() override { ++m_uses; }
+    int m_uses = 0;
+};
+
+
+TEST(Strategy, UseAndSetSkillDoNotAllocate) {
+    NopSkill nop;
+    Player player;
+    player.AddSkill("Nop", &nop);
+
+    const std::string nopName{ "Nop" };
+    const std::string missingName{ "Heal" };
+
+    EXPECT_NO_ALLOCATIONS(player.SetSkill(nopName));
+    EXPECT_NO_ALLOCATIONS(player.UseSkill());
+    EXPECT_TRUE(nop.m_uses == 1);
+
+    // Selecting a skill that does not exist must not insert it into the map.
+    EXPECT_NO_ALLOCATIONS(player.SetSkill(missingName));
+    EXPECT_NO_ALLOCATIONS(player.UseSkill());
+    EXPECT_TRUE(nop.m_uses == 1);
+}
@@ -0,0 +1,44 @@
+/*
+    Benchmarks for the Strategy demo: using and switching the current skill.
+
+    Updated: 2026-10-19
+    Author: Jonathan Helsing [github.com/Jonathan-source]
+*/
+
+#include "Player.h"
+#include "../Benchmarks/Benchmark.h"
+
+
+class NopSkill : public IPlayerSkill {
+public:
+    void Use() override { DoNotOptimize(this); }
+};
+
+
+int main(int argc, char* argv[])
+{
+    BenchmarkSuite suite{ ParseBenchmarkOptions(argc, argv) };
+    suite.PrintHeader();
+
+    FrostBolt frostBolt;
+    NopSkill nop;
+
+    Player player;
+    player.AddSkill("FrostBolt", &frostBolt);
+    player.AddSkill("Nop", &nop);
+
+    const std::string frostBoltName{ "FrostBolt" };
+    const std::string nopName{ "Nop" };
+
+    player.SetSkill(nopName);
+    suite.Run("Player::UseSkill (dispatch only)", [&] { player.UseSkill(); });
+    {
+        // The demo skills print what they do.
+        SilenceStdout silence;
+        player.SetSkill(frostBoltName);
+        suite.Run("Player::UseSkill (FrostBolt)", [&] { player.UseSkill(); });
+    }
+    suite.Run("Player::SetSkill", [&] { player.SetSkill(nopName); });
+
+    return suite.Finish();
+}
@@ -11,75 +11,7 @@
     Author: Jonathan Helsing [github.com/Jonathan-source]
 */
 
-#include <iostream>
-#include <unordered_map>
-
-
-class IPlayerSkill {
-public:
-    virtual ~IPlayerSkill() {}
-    virtual void Use(/* Player &player ? */) = 0;
-};
-
-
-class RestoreHP : public IPlayerSkill {
-public:
-    RestoreHP() = default;
-    virtual ~RestoreHP() = default;
-
-    void Use() override {
-        std::cout << "Using RestoreHP" << std::endl;
-    }
-};
-
-
-class FrostBolt : public IPlayerSkill {
-public:
-    FrostBolt() = default;
-    virtual ~FrostBolt() = default;
-
-    void Use() override {
-        std::cout << "Using FrostBolt" << std::endl;
-    }
-};
-
-
-class Flamestrike : public IPlayerSkill {
-public:
-    Flamestrike() = default;
-    virtual ~Flamestrike() = default;
-
-    void Use() override {
-        std::cout << "Using Flamestrike" << std::endl;
-    }
-};
-
-
-class Player {
-public:
-    Player() : m_pCurrentSkill(nullptr) {}
-    virtual ~Player() { m_skillMap.clear(); }
-
-    void UseSkill() {
-        if (m_pCurrentSkill) {
-            m_pCurrentSkill->Use();
-        }
-    }
-
-    void ClearSkill() { m_pCurrentSkill = nullptr; }
-
-    void SetSkill(const std::string& name) {
-        m_pCurrentSkill = m_skillMap[name];
-    }
-
-    void AddSkill(const std::string& name, IPlayerSkill* pSkill) {
-        m_skillMap[name] = pSkill;
-    }
-
-private:
-    std::unordered_map<std::string, IPlayerSkill*> m_skillMap;
-    IPlayerSkill* m_pCurrentSkill;
-};
+#include "Player.h"
 
 
 int main() 
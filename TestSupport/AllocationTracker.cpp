@@ -0,0 +1,137 @@
+#include "AllocationTracker.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#if defined(_WIN32)
+	#include <malloc.h>
+#endif
+
+namespace {
+
+// Constant-initialized, so touching it never allocates.
+thread_local AllocationCounters t_counters{ 0, 0, 0 };
+
+void* Allocate(std::size_t size) noexcept {
+	++t_counters.allocations;
+	t_counters.bytes += size;
+	return std::malloc(size > 0 ? size : 1);
+}
+
+void* AllocateAligned(std::size_t size, std::size_t alignment) noexcept {
+	++t_counters.allocations;
+	t_counters.bytes += size;
+#if defined(_WIN32)
+	return _aligned_malloc(size > 0 ? size : 1, alignment);
+#else
+	void* memory = nullptr;
+	return posix_memalign(&memory, alignment < sizeof(void*) ? sizeof(void*) : alignment, size > 0 ? size : 1) == 0 ? memory : nullptr;
+#endif
+}
+
+void Deallocate(void* memory) noexcept {
+	if (memory) {
+		++t_counters.deallocations;
+		std::free(memory);
+	}
+}
+
+void DeallocateAligned(void* memory) noexcept {
+	if (memory) {
+		++t_counters.deallocations;
+#if defined(_WIN32)
+		_aligned_free(memory);
+#else
+		std::free(memory);
+#endif
+	}
+}
+
+void* AllocateOrThrow(std::size_t size) {
+	void* memory = Allocate(size);
+	if (!memory) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* AllocateAlignedOrThrow(std::size_t size, std::size_t alignment) {
+	void* memory = AllocateAligned(size, alignment);
+	if (!memory) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+} // namespace
+
+AllocationCounters GetThreadAllocationCounters() noexcept {
+	return t_counters;
+}
+
+void* operator new(std::size_t size) { return AllocateOrThrow(size); }
+void* operator new[](std::size_t size) { return AllocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateAlignedOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateAlignedOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* memory) noexcept { Deallocate(memory); }
+void operator delete[](void* memory) noexcept { Deallocate(memory); }
+void operator delete(void* memory, std::size_t) noexcept { Deallocate(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { Deallocate(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { Deallocate(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { Deallocate(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { DeallocateAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { DeallocateAligned(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { DeallocateAligned(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { DeallocateAligned(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { DeallocateAligned(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { DeallocateAligned(memory); }
+
+
+namespace TestSupport {
+
+namespace {
+	int g_failures = 0;
+}
+
+std::vector<TestCase>& GetTestCases() {
+	static std::vector<TestCase> cases;
+	return cases;
+}
+
+void ReportFailure(const char* file, int line, const std::string& message) {
+	++g_failures;
+	std::cerr << file << ":" << line << ": " << message << "\n";
+}
+
+int RunTests(int argc, char* argv[]) {
+	int run = 0;
+	for (const TestCase& test : GetTestCases()) {
+		bool selected = argc <= 1;
+		for (int i = 1; i < argc; ++i) {
+			selected = selected || test.group == argv[i];
+		}
+		if (!selected) {
+			continue;
+		}
+
+		const int failuresBefore = g_failures;
+		test.body();
+		std::cout << (g_failures == failuresBefore ? "[ PASS ] " : "[ FAIL ] ") << test.group << "." << test.name << "\n";
+		++run;
+	}
+
+	std::cout << run << " test(s), " << g_failures << " failure(s)\n";
+	return g_failures == 0 && run > 0 ? 0 : 1;
+}
+
+} // namespace TestSupport
+
+int main(int argc, char* argv[]) {
+	return TestSupport::RunTests(argc, argv);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Allocation tracking for tests.
+ * Linking 'AllocationTracker.cpp' replaces the global operator new and
+ * delete with versions that count every allocation and deallocation of the
+ * calling thread. An 'AllocationScope' reports what happened on its thread
+ * between its construction and the query, so a test can assert that a hot
+ * path does not touch the heap:
+ *
+ *	EXPECT_NO_ALLOCATIONS(event.Broadcast(1));
+ */
+struct AllocationCounters {
+	std::size_t allocations;
+	std::size_t deallocations;
+	std::size_t bytes;		// Total bytes requested, not the live size.
+};
+
+// Counters of the calling thread since it started.
+AllocationCounters GetThreadAllocationCounters() noexcept;
+
+class AllocationScope {
+public:
+	AllocationScope() noexcept : m_start(GetThreadAllocationCounters()) {}
+
+	std::size_t GetAllocationCount() const noexcept {
+		return GetThreadAllocationCounters().allocations - m_start.allocations;
+	}
+
+	std::size_t GetDeallocationCount() const noexcept {
+		return GetThreadAllocationCounters().deallocations - m_start.deallocations;
+	}
+
+	std::size_t GetAllocatedBytes() const noexcept {
+		return GetThreadAllocationCounters().bytes - m_start.bytes;
+	}
+
+private:
+	AllocationCounters m_start;
+};
+
+
+/**
+ * A minimal test runner, so the tests need nothing but the standard library.
+ * Tests are registered with TEST(Group, Name); the test executable runs every
+ * test, or only those of the groups passed on the command line, and returns
+ * non-zero if any expectation failed.
+ */
+namespace TestSupport {
+
+struct TestCase {
+	std::string group;
+	std::string name;
+	std::function<void()> body;
+};
+
+std::vector<TestCase>& GetTestCases();
+void ReportFailure(const char* file, int line, const std::string& message);
+int RunTests(int argc, char* argv[]);
+
+struct TestRegistrar {
+	TestRegistrar(const char* group, const char* name, void (*body)()) {
+		GetTestCases().push_back({ group, name, body });
+	}
+};
+
+} // namespace TestSupport
+
+#define TEST(Group, Name)                                                               \
+    static void Group##_##Name();                                                       \
+    static const TestSupport::TestRegistrar Group##_##Name##_registrar{ #Group, #Name, Group##_##Name }; \
+    static void Group##_##Name()
+
+#define EXPECT_TRUE(condition)                                                          \
+    do {                                                                                \
+        if (!(condition)) {                                                             \
+            TestSupport::ReportFailure(__FILE__, __LINE__, "expected: " #condition);    \
+        }                                                                               \
+    } while (false)
+
+// Expects 'statement' to perform exactly 'expected' heap allocations.
+#define EXPECT_ALLOCATIONS(expected, statement)                                         \
+    do {                                                                                \
+        const AllocationScope allocationScope_;                                         \
+        statement;                                                                      \
+        const std::size_t allocations_ = allocationScope_.GetAllocationCount();         \
+        if (allocations_ != static_cast<std::size_t>(expected)) {                       \
+            TestSupport::ReportFailure(__FILE__, __LINE__, std::string(#statement)      \
+                + " performed " + std::to_string(allocations_) + " allocation(s) ("     \
+                + std::to_string(allocationScope_.GetAllocatedBytes()) + " bytes), expected " \
+                + std::to_string(expected));                                            \
+        }                                                                               \
+    } while (false)
+
+#define EXPECT_NO_ALLOCATIONS(statement) EXPECT_ALLOCATIONS(0, statement)
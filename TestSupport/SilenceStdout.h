@@ -0,0 +1,23 @@
+#pragma once
+
+#include <iostream>
+#include <streambuf>
+
+// Swallows everything written to std::cout while in scope, for hot paths that print.
+class SilenceStdout {
+public:
+	SilenceStdout() : m_previous(std::cout.rdbuf(&m_null)) {}
+	~SilenceStdout() { std::cout.rdbuf(m_previous); }
+
+	SilenceStdout(const SilenceStdout&) = delete;
+	SilenceStdout& operator=(const SilenceStdout&) = delete;
+
+private:
+	struct NullBuffer : std::streambuf {
+		int overflow(int c) override { return traits_type::not_eof(c); }
+		std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+	};
+
+	NullBuffer m_null;
+	std::streambuf* m_previous;
+};